@@ -0,0 +1,150 @@
+// Peak memory and time of decoding large cover art.
+//
+// g++ -std=c++17 -O2 -DMUSCLI_USE_LIBJPEG -I../src artMemoryBench.cpp
+//     ../src/Component/AlbumAsciiArt/StripDecoder/StripDecoder.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/MipChain.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/AreaResize/AreaResize.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/DominantColors/DominantColors.cpp
+//     -ljpeg -o artMemoryBench
+//
+// Encodes the starboy test cover enlarged to common embedded sizes as
+// baseline JPEGs, then decodes each to a MipChain with stb_image and with
+// the strip decoder. Every decode runs in its own child process, whose peak
+// resident set size is reported above that of a child that decodes nothing.
+// A time of -1 means the decode failed.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <jpeglib.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../src/stb/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../src/stb/stb_image_resize2.h"
+
+#include "../src/Component/AlbumAsciiArt/StripDecoder/StripDecoder.h"
+
+std::vector<unsigned char> encodeJPEG(const std::vector<unsigned char>& rgb,
+                                      int size) {
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr err;
+    cinfo.err = jpeg_std_error(&err);
+    jpeg_create_compress(&cinfo);
+    unsigned char* out = nullptr;
+    unsigned long outSize = 0;
+    jpeg_mem_dest(&cinfo, &out, &outSize);
+    cinfo.image_width = size;
+    cinfo.image_height = size;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, 90, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = const_cast<unsigned char*>(
+            &rgb[static_cast<size_t>(cinfo.next_scanline) * size * 3]);
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    std::vector<unsigned char> bytes(out, out + outSize);
+    free(out);
+    return bytes;
+}
+
+// Runs f in a child process, returning its peak RSS in KB and time in ms
+template <typename F>
+void measure(F&& f, long& peakKB, double& ms) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        peakKB = 0;
+        ms = 0;
+        return;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = f();
+        auto end = std::chrono::steady_clock::now();
+        double elapsed =
+            ok ? std::chrono::duration<double, std::milli>(end - start).count()
+               : -1.0;
+        ssize_t written = write(fds[1], &elapsed, sizeof(elapsed));
+        _exit(written == sizeof(elapsed) ? 0 : 1);
+    }
+    close(fds[1]);
+    ms = -1.0;
+    if (read(fds[0], &ms, sizeof(ms)) != sizeof(ms)) {
+        ms = -1.0;
+    }
+    close(fds[0]);
+    int status = 0;
+    rusage usage{};
+    wait4(pid, &status, 0, &usage);
+    peakKB = usage.ru_maxrss;
+}
+
+int main() {
+    if (!StripDecoder::available()) {
+        std::cerr << "Error: Build with -DMUSCLI_USE_LIBJPEG -ljpeg"
+                  << std::endl;
+        return 1;
+    }
+    int width, height, channels;
+    unsigned char* source =
+        stbi_load("../src/starboy.png", &width, &height, &channels, 3);
+    if (!source) {
+        std::cerr << "Error: Could not load the test cover" << std::endl;
+        return 1;
+    }
+
+    for (int size : {1000, 3000, 5000}) {
+        std::vector<unsigned char> rgb(static_cast<size_t>(size) * size * 3);
+        stbir_resize_uint8_srgb(source, width, height, 0, rgb.data(), size,
+                                size, 0, STBIR_RGB);
+        std::vector<unsigned char> jpeg = encodeJPEG(rgb, size);
+        rgb = std::vector<unsigned char>();
+
+        // The children start with this process's pages
+        long idleKB, stbKB, stripKB;
+        double idleMs, stbMs, stripMs;
+        measure([] { return true; }, idleKB, idleMs);
+        measure(
+            [&] {
+                int w, h, c;
+                unsigned char* pixels = stbi_load_from_memory(
+                    jpeg.data(), static_cast<int>(jpeg.size()), &w, &h, &c,
+                    4);
+                if (!pixels) {
+                    return false;
+                }
+                bool ok = MipChain::fromImage(pixels, w, h) != nullptr;
+                stbi_image_free(pixels);
+                return ok;
+            },
+            stbKB, stbMs);
+        measure(
+            [&] {
+                return StripDecoder::decode(jpeg.data(), jpeg.size(),
+                                            ResizeFilter::Area) != nullptr;
+            },
+            stripKB, stripMs);
+
+        std::cout << size << "x" << size << " (" << jpeg.size() / 1024
+                  << " KB JPEG)\n"
+                  << "  stb_image: " << (stbKB - idleKB) / 1024.0
+                  << " MB peak, " << stbMs << " ms\n"
+                  << "  strips:    " << (stripKB - idleKB) / 1024.0
+                  << " MB peak, " << stripMs << " ms\n";
+    }
+    stbi_image_free(source);
+    return 0;
+}
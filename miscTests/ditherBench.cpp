@@ -0,0 +1,135 @@
+// Benchmark of dithering album art to the 256 and 16 color palettes.
+//
+// g++ -std=c++17 -O2 -I../src ditherBench.cpp
+//     ../src/Component/AlbumAsciiArt/Ditherer/Ditherer.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/MipChain.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/AreaResize/AreaResize.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/DominantColors/DominantColors.cpp
+//     ../src/ColoredChar/Palette/Palette.cpp -o ditherBench
+//
+// The starboy test cover is resized to the pixels of art at a few sizes, from
+// 30x15 half block art up to the 256 pixel base level, then mapped to each
+// palette without dithering, with the Bayer matrix and with error diffusion.
+// Reports the time of each and how far the mean color of 8x8 tiles ends up
+// from the cover's, per channel out of 255, which is the banding dithering
+// is meant to remove.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../src/stb/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../src/stb/stb_image_resize2.h"
+
+#include "../src/ColoredChar/ColoredChar.h"
+#include "../src/ColoredChar/Palette/Palette.h"
+#include "../src/Component/AlbumAsciiArt/Ditherer/Ditherer.h"
+
+template <typename F>
+double timeUs(F&& f, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           iterations;
+}
+
+// Nearest palette entry of every pixel, what the terminal would show
+void nearest(const std::vector<unsigned char>& rgba, ColorTier tier,
+             std::vector<uint32_t>& out) {
+    for (size_t i = 0; i < out.size(); ++i) {
+        const unsigned char* p = &rgba[i * 4];
+        uint32_t color = (static_cast<uint32_t>(p[0]) << 24) |
+                         (static_cast<uint32_t>(p[1]) << 16) |
+                         (static_cast<uint32_t>(p[2]) << 8) | 0xFF;
+        out[i] = Palette::nearest(tier, color);
+    }
+}
+
+// Mean difference of 8x8 tile averages between the pixels and the palette
+// colors they were mapped to
+double tileError(const std::vector<unsigned char>& rgba,
+                 const std::vector<uint32_t>& colors, int w, int h) {
+    double total = 0;
+    int tiles = 0;
+    for (int ty = 0; ty + 8 <= h; ty += 8) {
+        for (int tx = 0; tx + 8 <= w; tx += 8) {
+            double source[3] = {0, 0, 0};
+            double shown[3] = {0, 0, 0};
+            for (int y = ty; y < ty + 8; ++y) {
+                for (int x = tx; x < tx + 8; ++x) {
+                    size_t i = static_cast<size_t>(y) * w + x;
+                    uint32_t c = Palette::rgba(paletteIndex(colors[i]));
+                    for (int ch = 0; ch < 3; ++ch) {
+                        source[ch] += rgba[i * 4 + ch];
+                        shown[ch] += (c >> (24 - 8 * ch)) & 0xFF;
+                    }
+                }
+            }
+            for (int ch = 0; ch < 3; ++ch) {
+                total += std::abs(source[ch] - shown[ch]) / 64;
+            }
+            ++tiles;
+        }
+    }
+    return tiles == 0 ? 0 : total / (tiles * 3);
+}
+
+void run(const unsigned char* cover, int coverW, int coverH, int w, int h) {
+    std::vector<unsigned char> rgba(static_cast<size_t>(w) * h * 4);
+    stbir_resize_uint8_srgb(cover, coverW, coverH, 0, rgba.data(), w, h, 0,
+                            STBIR_RGBA);
+    std::vector<uint32_t> out(static_cast<size_t>(w) * h);
+    int iterations = w * h > 10000 ? 200 : 2000;
+
+    for (ColorTier tier : {ColorTier::Colors256, ColorTier::Colors16}) {
+        std::cout << "  " << w << "x" << h << " "
+                  << (tier == ColorTier::Colors256 ? "256" : "16")
+                  << " colors:";
+        double plain = timeUs([&] { nearest(rgba, tier, out); }, iterations);
+        std::cout << " nearest " << plain << " us (tile error "
+                  << tileError(rgba, out, w, h) << ")";
+        for (DitherMethod method :
+             {DitherMethod::Ordered, DitherMethod::ErrorDiffusion}) {
+            double us = timeUs(
+                [&] {
+                    Ditherer::ditherPixels(rgba.data(), w, h, tier, method,
+                                           out.data());
+                },
+                iterations);
+            std::cout << (method == DitherMethod::Ordered ? ", ordered "
+                                                          : ", diffusion ")
+                      << us << " us (tile error "
+                      << tileError(rgba, out, w, h) << ")";
+        }
+        std::cout << "\n";
+    }
+}
+
+int main() {
+    int width, height, channels;
+    unsigned char* source =
+        stbi_load("../src/starboy.png", &width, &height, &channels, 4);
+    if (!source) {
+        std::cerr << "Error: Could not load the test cover" << std::endl;
+        return 1;
+    }
+
+    // Builds both nearest color tables outside the timings
+    Palette::nearestTable(ColorTier::Colors256);
+    Palette::nearestTable(ColorTier::Colors16);
+
+    run(source, width, height, 30, 30);
+    run(source, width, height, 60, 60);
+    run(source, width, height, 120, 120);
+    run(source, width, height, 256, 256);
+    stbi_image_free(source);
+    return 0;
+}
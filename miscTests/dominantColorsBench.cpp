@@ -0,0 +1,81 @@
+// Benchmark of the dominant color extraction run for each new cover.
+//
+// g++ -std=c++17 -O2 -I../src dominantColorsBench.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/MipChain.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/AreaResize/AreaResize.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/DominantColors/DominantColors.cpp
+//     -o dominantColorsBench
+//
+// Times DominantColors::extract() on the level of the starboy test cover's
+// chain that MipChain samples, next to building the whole chain, and on
+// random noise, the worst case where nearly every pixel is its own group.
+// Prints the colors found and the accent picked from them.
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../src/stb/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../src/stb/stb_image_resize2.h"
+
+#include "../src/Component/AlbumAsciiArt/MipChain/DominantColors/DominantColors.h"
+#include "../src/Component/AlbumAsciiArt/MipChain/MipChain.h"
+
+template <typename F>
+double timeUs(F&& f, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           iterations;
+}
+
+void printColors(const std::vector<uint32_t>& colors) {
+    for (uint32_t color : colors) {
+        std::printf(" #%06x", color >> 8);
+    }
+    std::printf(", accent #%06x\n",
+                DominantColors::accent(colors, 0xFFFFFFFF) >> 8);
+}
+
+int main() {
+    int width, height, channels;
+    unsigned char* source =
+        stbi_load("../src/starboy.png", &width, &height, &channels, 4);
+    if (!source) {
+        std::cerr << "Error: Could not load the test cover" << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<const MipChain> chain;
+    double build = timeUs(
+        [&] { chain = MipChain::fromImage(source, width, height); }, 20);
+    const MipChain::Level& sample = chain->nearest(
+        DominantColors::SAMPLE_SIZE, DominantColors::SAMPLE_SIZE);
+    size_t pixels = static_cast<size_t>(sample.width) * sample.height;
+    double extract = timeUs(
+        [&] { DominantColors::extract(sample.rgba.data(), pixels); }, 1000);
+    std::cout << width << "x" << height << " cover: chain " << build
+              << " us, extract from " << sample.width << "x" << sample.height
+              << " " << extract << " us\n ";
+    printColors(chain->dominantColors());
+
+    std::mt19937 rng(1);
+    std::vector<unsigned char> noise(pixels * 4);
+    for (size_t i = 0; i < noise.size(); ++i) {
+        noise[i] = i % 4 == 3 ? 255 : static_cast<unsigned char>(rng());
+    }
+    double worst = timeUs(
+        [&] { DominantColors::extract(noise.data(), pixels); }, 1000);
+    std::cout << "noise: extract " << worst << " us\n ";
+    printColors(DominantColors::extract(noise.data(), pixels));
+    stbi_image_free(source);
+    return 0;
+}
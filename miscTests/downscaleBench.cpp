@@ -0,0 +1,126 @@
+// Benchmark of the area downscaler against stb_image_resize on cover art.
+//
+// g++ -std=c++17 -O2 -I../src downscaleBench.cpp
+//     ../src/Component/AlbumAsciiArt/MipChain/AreaResize/AreaResize.cpp
+//     -o downscaleBench
+//
+// Usage: downscaleBench cover.jpg [cover.png ...]
+//
+// Give it real cover art of at least 500 pixels. Enlarged covers are smooth
+// and flatter both the speed and the difference figures, so each size is a
+// centre crop of the image given, never a resize of it; sizes larger than
+// an image are skipped. Every crop is reduced to the 256 pixel base level of
+// a MipChain, by 3x where MipChain starts using the area filter, and
+// straight to the pixels of 30x15 half block art. Reports the time of both
+// resizers and the mean absolute difference of their output per channel,
+// out of 255.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../src/stb/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../src/stb/stb_image_resize2.h"
+
+#include "../src/Component/AlbumAsciiArt/MipChain/AreaResize/AreaResize.h"
+
+template <typename F>
+double timeUs(F&& f, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           iterations;
+}
+
+void run(const std::vector<unsigned char>& cover, int size, int outW,
+         int outH) {
+    std::vector<unsigned char> a(static_cast<size_t>(outW) * outH * 4);
+    std::vector<unsigned char> b(a.size());
+    int iterations = size >= 2000 ? 5 : 20;
+
+    double stb = timeUs(
+        [&] {
+            stbir_resize_uint8_srgb(cover.data(), size, size, 0, a.data(),
+                                    outW, outH, 0, STBIR_RGBA);
+        },
+        iterations);
+    double area = timeUs(
+        [&] {
+            resizeArea(cover.data(), size, size, b.data(), outW, outH);
+        },
+        iterations);
+
+    long difference = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        difference += std::abs(a[i] - b[i]);
+    }
+
+    std::cout << "  " << size << "x" << size << " -> " << outW << "x" << outH
+              << ": stbir " << stb << " us, area " << area << " us ("
+              << stb / area << "x), mean difference "
+              << static_cast<double>(difference) / a.size() << "\n";
+}
+
+// Copies the centre size x size square of an RGBA image
+std::vector<unsigned char> crop(const unsigned char* pixels, int width,
+                                int height, int size) {
+    std::vector<unsigned char> square(static_cast<size_t>(size) * size * 4);
+    int left = (width - size) / 2;
+    int top = (height - size) / 2;
+    for (int y = 0; y < size; ++y) {
+        const unsigned char* row =
+            pixels + (static_cast<size_t>(top + y) * width + left) * 4;
+        std::copy(row, row + static_cast<size_t>(size) * 4,
+                  square.begin() + static_cast<size_t>(y) * size * 4);
+    }
+    return square;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " cover [cover ...]" << std::endl;
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        int width, height, channels;
+        unsigned char* source =
+            stbi_load(argv[i], &width, &height, &channels, 4);
+        if (!source) {
+            std::cerr << "Error: Could not load " << argv[i] << std::endl;
+            continue;
+        }
+        std::cout << argv[i] << " (" << width << "x" << height << ")\n";
+
+        for (int size : {500, 600, 768, 1000, 1200, 1400, 3000}) {
+            if (size > width || size > height) {
+                continue;
+            }
+            std::vector<unsigned char> cover =
+                crop(source, width, height, size);
+            std::cout << size << "x" << size << " crop\n";
+            run(cover, size, 256, 256);
+            if (size / 3 != 256) {
+                run(cover, size, size / 3, size / 3);
+            }
+            run(cover, size, 60, 30);
+        }
+
+        // The halvings below the base level are whole ratios
+        int size = std::min(width, height);
+        if (size >= 256) {
+            std::cout << "256x256 crop\n";
+            run(crop(source, width, height, 256), 256, 128, 128);
+        }
+        stbi_image_free(source);
+    }
+    return 0;
+}
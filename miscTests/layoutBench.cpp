@@ -0,0 +1,104 @@
+// Benchmark for the layout engine on deep and wide trees.
+//
+// g++ -std=c++17 -O2 layoutBench.cpp ../src/Layout/Layout.cpp -o layoutBench
+//
+// Reports the time and number of recomputed nodes for a full layout, a root
+// resize, a constraint change on one deep leaf and an update with no changes.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "../src/Layout/Layout.h"
+
+// Minimal component so leaves have something to position
+class Box : public Component {
+   public:
+    Box() : Component(0, 0, 1, 1) {}
+    ColoredChar pixelAt(int32_t, int32_t) const override {
+        return BLANK_CHARACTER;
+    }
+};
+
+// Builds a tree with `depth` levels below the root where every container has
+// `fanout` children, alternating direction per level. Returns the leaves.
+void build(Layout& layout, LayoutNode* parent, int depth, int fanout,
+           std::vector<Box>& boxes, size_t& nextBox,
+           std::vector<LayoutNode*>& leaves) {
+    Direction dir = depth % 2 == 0 ? Direction::Horizontal : Direction::Vertical;
+    for (int i = 0; i < fanout; ++i) {
+        if (depth == 0) {
+            leaves.push_back(layout.addComponent(parent, &boxes[nextBox++],
+                                                 SizeSpec::flex(),
+                                                 SizeSpec::flex(), true));
+        } else {
+            SizeSpec main = i == 0 ? SizeSpec::percent(30) : SizeSpec::flex();
+            LayoutNode* node = layout.addStack(parent, dir, main, main);
+            node->setPadding(Padding::uniform(1));
+            build(layout, node, depth - 1, fanout, boxes, nextBox, leaves);
+        }
+    }
+}
+
+template <typename F>
+double timeUs(F&& f, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           iterations;
+}
+
+void run(int depth, int fanout) {
+    size_t leafCount = 1;
+    for (int i = 0; i <= depth; ++i) {
+        leafCount *= fanout;
+    }
+
+    Layout layout;
+    std::vector<Box> boxes(leafCount);
+    std::vector<LayoutNode*> leaves;
+    size_t nextBox = 0;
+    build(layout, layout.getRoot(), depth, fanout, boxes, nextBox, leaves);
+
+    const int iterations = 200;
+    LayoutRect bounds{0, 0, 4000, 4000};
+
+    double full = timeUs(
+        [&](int i) {
+            // Alternate between two sizes so every iteration is a full resize
+            bounds.width = i % 2 == 0 ? 4000 : 3990;
+            layout.update(bounds);
+        },
+        iterations);
+    size_t fullVisits = layout.getLastVisitCount();
+
+    double leaf = timeUs(
+        [&](int i) {
+            leaves[leaves.size() / 2]->setWidth(
+                i % 2 == 0 ? SizeSpec::flex(2) : SizeSpec::flex(1));
+            layout.update(bounds);
+        },
+        iterations);
+    size_t leafVisits = layout.getLastVisitCount();
+
+    double clean = timeUs([&](int) { layout.update(bounds); }, iterations);
+
+    std::cout << "depth " << depth << " fanout " << fanout << " ("
+              << leafCount << " leaves)\n"
+              << "  resize:      " << full << " us, " << fullVisits
+              << " nodes\n"
+              << "  leaf change: " << leaf << " us, " << leafVisits
+              << " nodes\n"
+              << "  no change:   " << clean << " us\n";
+}
+
+int main() {
+    run(12, 2);
+    run(6, 4);
+    run(3, 16);
+    return 0;
+}
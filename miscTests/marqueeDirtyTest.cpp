@@ -0,0 +1,53 @@
+// Checks that restyling a scrolled marquee marks the cells it shows on.
+//
+// g++ -std=c++17 -I../src marqueeDirtyTest.cpp ../src/Component/Text/Text.cpp
+//     ../src/Component/Text/MarkupTemplate/MarkupTemplate.cpp
+//     ../src/Unicode/DisplayWidth/DisplayWidth.cpp
+//     ../src/Unicode/Grapheme/Grapheme.cpp
+//     ../src/Unicode/Grapheme/GraphemeCache/GraphemeCache.cpp
+//     ../src/Unicode/Grapheme/ClusterTable/ClusterTable.cpp
+//     ../src/Unicode/UTF8/UTF8.cpp -o marqueeDirtyTest
+//
+// A partial redraw only repaints the dirty area, so every cell whose look
+// changed has to be in it. Scrolls a marquee until the painted character
+// sits at another column, paints it and checks the column it shows at.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "../src/Component/Text/Text.h"
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        std::exit(1);
+    }
+}
+
+int main() {
+    Text text(0, 0, "Some artist with a long name", 255, 255, 255);
+    text.setMarquee(8);
+    text.advanceMarquee(5);
+    text.markDrawn({});
+
+    // Character 6 now shows at column 1
+    check(text.pixelAt(1, 0).c == U'r', "scrolled to the painted character");
+    text.paintFG(CCHAR_RED, 6, 1);
+    check(text.pixelAt(1, 0).rgba_fg == CCHAR_RED, "painted");
+
+    ClipRect area = text.getDirtyArea();
+    check(text.isDirty(), "painting marks the text dirty");
+    check(area.left <= 1 && area.right > 1 && area.top <= 0 &&
+              area.bottom > 0,
+          "dirty area covers the column the character shows at");
+
+    // Without a marquee only the painted cells are marked
+    text.stopMarquee();
+    text.markDrawn({});
+    text.paintFG(CCHAR_GREEN, 6, 1);
+    area = text.getDirtyArea();
+    check(area.left == 6 && area.right == 7, "plain text marks its cells");
+
+    std::cout << "ok" << std::endl;
+    return 0;
+}
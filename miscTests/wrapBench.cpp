@@ -0,0 +1,66 @@
+// Benchmark for rewrapping Text when its width changes.
+//
+// g++ -std=c++17 -O2 -I../src wrapBench.cpp ../src/Component/Text/Text.cpp
+//     ../src/Component/Text/MarkupTemplate/MarkupTemplate.cpp
+//     ../src/Unicode/DisplayWidth/DisplayWidth.cpp
+//     ../src/Unicode/Grapheme/Grapheme.cpp
+//     ../src/Unicode/Grapheme/GraphemeCache/GraphemeCache.cpp
+//     ../src/Unicode/Grapheme/ClusterTable/ClusterTable.cpp
+//     ../src/Unicode/UTF8/UTF8.cpp -o wrapBench
+//
+// Lyrics are the largest text the player wraps. Builds about 14 KB of
+// lyric-like lines and reports the time of one rewrap when a resize
+// alternates between two widths, as a terminal resize does, for a few
+// column widths, along with the number of visual lines.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../src/Component/Text/Text.h"
+
+template <typename F>
+double timeUs(F&& f, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           iterations;
+}
+
+int main() {
+    const char* words[] = {"I",       "never",   "thought", "the",
+                           "night",   "would",   "end",     "like",
+                           "this,",   "running", "through", "neon",
+                           "streets", "again",   "and",     "again"};
+    std::string lyrics;
+    size_t word = 0;
+    while (lyrics.size() < 14 * 1024) {
+        // Lines of five to twelve words with a blank line between verses
+        size_t count = 5 + word % 8;
+        for (size_t i = 0; i < count; ++i) {
+            lyrics += words[word++ % 16];
+            lyrics += i + 1 < count ? " " : "\n";
+        }
+        if (word % 61 < 8) {
+            lyrics += "\n";
+        }
+    }
+
+    Text text(0, 0, lyrics, 255, 255, 255);
+    std::cout << lyrics.size() << " bytes of lyrics\n";
+    for (int width : {20, 40, 80, 120}) {
+        text.setMaxWidth(width, TextOverflow::Wrap);
+        int iterations = 1000;
+        double us = timeUs(
+            [&](int i) {
+                text.resize(static_cast<uint32_t>(width + i % 2 * 7), 10);
+            },
+            iterations);
+        std::cout << "  width " << width << ": " << text.getLineCount()
+                  << " lines, rewrap " << us << " us\n";
+    }
+    return 0;
+}
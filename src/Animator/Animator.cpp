@@ -0,0 +1,114 @@
+/**
+ * @file Animator.cpp
+ * @author Amin Karic
+ * @brief Animator implementation file
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Animator.h"
+
+#include <algorithm>
+
+Animator::~Animator() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (frameTimer != 0) {
+        renderer.cancelTimer(frameTimer);
+    }
+}
+
+AnimationId Animator::animate(Component* target,
+                              std::chrono::milliseconds duration, float from,
+                              float to, std::function<void(float)> apply,
+                              EasingFn easing,
+                              std::function<void()> onComplete) {
+    std::lock_guard<std::mutex> lock(mtx);
+    AnimationId id = nextId++;
+    animations.push_back({id, target, TimerClock::now(), duration, from, to,
+                          easing, std::move(apply), std::move(onComplete)});
+
+    // The frame timer only exists while something is animating
+    if (frameTimer == 0) {
+        frameTimer = renderer.schedulePeriodic(frameInterval,
+                                               [this]() { tick(); });
+    }
+    return id;
+}
+
+bool Animator::cancel(AnimationId id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto found = std::find_if(
+        animations.begin(), animations.end(),
+        [id](const Animation& a) { return a.id == id; });
+    if (found == animations.end()) {
+        return false;
+    }
+    animations.erase(found);
+    stopIfIdle();
+    return true;
+}
+
+void Animator::cancelAll(const Component* target) {
+    std::lock_guard<std::mutex> lock(mtx);
+    animations.erase(
+        std::remove_if(
+            animations.begin(), animations.end(),
+            [target](const Animation& a) { return a.target == target; }),
+        animations.end());
+    stopIfIdle();
+}
+
+bool Animator::isAnimating() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return !animations.empty();
+}
+
+void Animator::stopIfIdle() {
+    if (animations.empty() && frameTimer != 0) {
+        renderer.cancelTimer(frameTimer);
+        frameTimer = 0;
+    }
+}
+
+void Animator::tick() {
+    std::vector<std::function<void()>> finished;
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        TimerClock::time_point now = TimerClock::now();
+
+        for (auto i = animations.begin(); i != animations.end();) {
+            float t = 1.0f;
+            if (i->duration > TimerClock::duration::zero()) {
+                t = std::chrono::duration<float>(now - i->start).count() /
+                    std::chrono::duration<float>(i->duration).count();
+                t = std::clamp(t, 0.0f, 1.0f);
+            }
+
+            i->apply(i->from + (i->to - i->from) * i->easing(t));
+            if (i->target != nullptr) {
+                i->target->markDirty();
+            }
+            changed = true;
+
+            if (t >= 1.0f) {
+                finished.push_back(std::move(i->onComplete));
+                i = animations.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        stopIfIdle();
+    }
+
+    if (changed) {
+        renderer.requestPartialRedraw();
+    }
+    for (auto& callback : finished) {
+        if (callback) {
+            callback();
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file Animator.h
+ * @author Amin Karic
+ * @brief Animator class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * The Animator interpolates component properties over time. While at least
+ * one animation is running it keeps a frame timer on the Renderer's timer
+ * wheel, and on every frame it applies the new values, marks the animated
+ * components dirty and requests a partial redraw. When the last animation
+ * ends the timer is cancelled and the render loop goes back to sleeping until
+ * an event arrives.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "../Component/Component.h"
+#include "../Renderer/Renderer.h"
+#include "../TimerWheel/TimerWheel.h"
+
+using AnimationId = uint64_t;
+
+/**
+ * @brief Maps linear progress in [0, 1] to eased progress.
+ */
+using EasingFn = float (*)(float);
+
+namespace Easing {
+
+inline float linear(float t) { return t; }
+
+inline float easeInQuad(float t) { return t * t; }
+
+inline float easeOutQuad(float t) { return t * (2.0f - t); }
+
+inline float easeInOutQuad(float t) {
+    return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+}
+
+inline float easeOutCubic(float t) {
+    float u = 1.0f - t;
+    return 1.0f - u * u * u;
+}
+
+}  // namespace Easing
+
+/**
+ * @class Animator
+ *
+ * @brief Runs time based tweens on the renderer thread.
+ *
+ * @details
+ * Animations may be started and cancelled from any thread. Their setters and
+ * completion callbacks run on the renderer thread, the same thread that draws,
+ * so setters can modify components without further locking.
+ */
+class Animator {
+   private:
+    /**
+     * @brief A running tween.
+     */
+    struct Animation {
+        AnimationId id;
+        Component* target;  // Component marked dirty every frame, may be null
+        TimerClock::time_point start;
+        TimerClock::duration duration;
+        float from;
+        float to;
+        EasingFn easing;
+        std::function<void(float)> apply;   // Sets the animated property
+        std::function<void()> onComplete;   // Runs once the tween finished
+    };
+
+    Renderer& renderer;  // Renderer that owns the frame timer
+    std::chrono::milliseconds frameInterval;  // Time between frames
+    std::mutex mtx;                           // Protects the members below
+    std::vector<Animation> animations;
+    AnimationId nextId = 1;
+    TimerId frameTimer = 0;  // Frame timer on the renderer, 0 when idle
+
+    /**
+     * @brief Advances every animation by one frame.
+     */
+    void tick();
+
+    /**
+     * @brief Cancels the frame timer if nothing is animating.
+     */
+    void stopIfIdle();
+
+   public:
+    // Requires refrences therefore we cannot have default ctor
+    Animator() = delete;
+
+    /**
+     * @brief Construct a new Animator
+     *
+     * @param renderer renderer whose thread runs the animations
+     * @param frameInterval time between frames, caps the redraw rate while
+     * animating
+     */
+    explicit Animator(Renderer& renderer,
+                      std::chrono::milliseconds frameInterval =
+                          std::chrono::milliseconds(16))
+        : renderer(renderer), frameInterval(frameInterval){};
+
+    // Animator is non-copyable and non-movable, the frame timer refers to it
+    Animator(const Animator& other) = delete;
+    Animator& operator=(Animator const& other) = delete;
+    Animator(Animator&& other) noexcept = delete;
+    Animator& operator=(Animator&& other) noexcept = delete;
+
+    ~Animator();
+
+    /**
+     * @brief Starts a tween.
+     *
+     * @param target component to redraw every frame, may be null if the
+     * setter marks components dirty itself
+     * @param duration length of the tween
+     * @param from start value
+     * @param to end value
+     * @param apply setter receiving the interpolated value. It runs under the
+     * animator's lock and must not start or cancel animations, use
+     * @p onComplete to chain tweens.
+     * @param easing easing curve
+     * @param onComplete called after the final value was applied
+     * @return AnimationId id that can be passed to cancel()
+     */
+    AnimationId animate(Component* target, std::chrono::milliseconds duration,
+                        float from, float to,
+                        std::function<void(float)> apply,
+                        EasingFn easing = Easing::easeOutQuad,
+                        std::function<void()> onComplete = {});
+
+    /**
+     * @brief Stops a tween, leaving the property at its current value.
+     *
+     * @param id id returned by animate()
+     * @return bool true if the tween was running, false otherwise
+     */
+    bool cancel(AnimationId id);
+
+    /**
+     * @brief Stops every tween targeting a component.
+     *
+     * @param target component whose tweens to stop
+     */
+    void cancelAll(const Component* target);
+
+    /**
+     * @brief Returns whether any tween is running.
+     */
+    bool isAnimating();
+};
@@ -8,7 +8,8 @@
  *
  * @details
  * ColoredChar represents a single renderable cell consisting of a Unicode
- * code point stored as UTF-32 and a 32-bit RGBA color.
+ * code point stored as UTF-32, 32-bit RGBA foreground and background colors
+ * and text attributes such as bold.
  */
 
 #pragma once
@@ -16,8 +17,12 @@
 #include <cstdint>
 #include <ostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
+#include "../Unicode/Grapheme/ClusterTable/ClusterTable.h"
+#include "../Unicode/UTF8/UTF8.h"
+
 /**
  * @name ANSI color and character constants
  * @{
@@ -35,6 +40,55 @@ inline constexpr uint32_t CCHAR_YELLOW = 0xFFFF00FF;
 inline constexpr uint32_t CCHAR_CYAN = 0x00FFFFFF;
 inline constexpr uint32_t CCHAR_MAGENTA = 0xFF00FFFF;
 
+/**
+ * @brief Fully transparent color, leaves the terminal's default color.
+ */
+inline constexpr uint32_t CCHAR_DEFAULT = 0x00000000;
+
+/**
+ * @brief Alpha marking a color as an index into the terminal's 256 color
+ * palette rather than RGB, for terminals without truecolor.
+ */
+inline constexpr uint32_t CCHAR_PALETTE_ALPHA = 0x01;
+
+/**
+ * @brief Returns the color of a terminal palette entry.
+ *
+ * @param index xterm palette index, 0 to 15 are the terminal's own colors
+ */
+constexpr uint32_t paletteColor(uint8_t index) noexcept {
+    return (static_cast<uint32_t>(index) << 8) | CCHAR_PALETTE_ALPHA;
+}
+
+/**
+ * @brief Returns true if a color is a terminal palette entry.
+ */
+constexpr bool isPaletteColor(uint32_t rgba) noexcept {
+    return (rgba & 0xFF) == CCHAR_PALETTE_ALPHA;
+}
+
+/**
+ * @brief Returns the palette index of a color made by paletteColor().
+ */
+constexpr uint8_t paletteIndex(uint32_t rgba) noexcept {
+    return static_cast<uint8_t>(rgba >> 8);
+}
+
+/**
+ * @brief Text attribute bits, combined with bitwise or.
+ */
+inline constexpr uint8_t CCHAR_BOLD = 0x01;
+inline constexpr uint8_t CCHAR_DIM = 0x02;
+inline constexpr uint8_t CCHAR_ITALIC = 0x04;
+inline constexpr uint8_t CCHAR_UNDERLINE = 0x08;
+inline constexpr uint8_t CCHAR_REVERSE = 0x10;
+
+/**
+ * @brief Code point of the cell covered by the right half of a wide
+ * character. The character itself is stored in the cell to its left.
+ */
+inline constexpr char32_t CCHAR_CONTINUATION = 0;
+
 /**
  * @brief ANSI escape sequence that resets all terminal attributes.
  */
@@ -45,13 +99,20 @@ inline constexpr const char* ANSI_RESET = "\x1b[0m";
 /**
  * @brief Encodes a single UTF-32 code point as UTF-8.
  *
- * @param c Unicode code point.
+ * @param c Unicode code point, or a cell referring to a ClusterTable cluster.
  * @return UTF-8 encoded string.
  *
  * @note
  * This function is intended for terminal output of individual characters.
  */
 inline std::string toUTF8(char32_t c) {
+    if (ClusterTable::isCluster(c)) {
+        // Interned clusters are stored encoded
+        const ClusterTable::Cluster* cluster = ClusterTable::find(c);
+        return cluster != nullptr ? cluster->utf8
+                                  : toUTF8(REPLACEMENT_CHARACTER);
+    }
+
     uint32_t code = static_cast<uint32_t>(c);
     std::string out;
 
@@ -101,8 +162,11 @@ inline std::string toUTF8(char32_t c) {
  * - first  = number of bytes consumed
  * - second = decoded Unicode code point (UTF-32)
  *
+ * Malformed sequences decode to REPLACEMENT_CHARACTER, consuming the longest
+ * prefix that could have started a valid sequence, so callers always make
+ * progress. Prefer decodeUTF8() for whole strings.
+ *
  * @throws std::out_of_range if @p i is outside the bounds of the string.
- * @throws std::runtime_error if the UTF-8 sequence is malformed.
  */
 inline std::pair<size_t, char32_t> decodeUTF8Char(const std::string& str,
                                                   size_t i) {
@@ -110,58 +174,11 @@ inline std::pair<size_t, char32_t> decodeUTF8Char(const std::string& str,
         throw std::out_of_range("Index out of range in decodeUTF8Char");
     }
 
-    unsigned char byte1 = static_cast<unsigned char>(str[i]);
-
-    if (byte1 <= 0x7F) {
-        // 1-byte ASCII
-        return {1, static_cast<char32_t>(byte1)};
-
-    } else if ((byte1 & 0xE0) == 0xC0) {
-        // 2-byte sequence
-        if (i + 1 >= str.size()) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        unsigned char byte2 = static_cast<unsigned char>(str[i + 1]);
-        if ((byte2 & 0xC0) != 0x80) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        return {2,
-                static_cast<char32_t>(((byte1 & 0x1F) << 6) | (byte2 & 0x3F))};
-
-    } else if ((byte1 & 0xF0) == 0xE0) {
-        // 3-byte sequence
-        if (i + 2 >= str.size()) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        unsigned char byte2 = static_cast<unsigned char>(str[i + 1]);
-        unsigned char byte3 = static_cast<unsigned char>(str[i + 2]);
-        if ((byte2 & 0xC0) != 0x80 || (byte3 & 0xC0) != 0x80) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        return {3,
-                static_cast<char32_t>(((byte1 & 0x0F) << 12) |
-                                      ((byte2 & 0x3F) << 6) | (byte3 & 0x3F))};
-
-    } else if ((byte1 & 0xF8) == 0xF0) {
-        // 4-byte sequence
-        if (i + 3 >= str.size()) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        unsigned char byte2 = static_cast<unsigned char>(str[i + 1]);
-        unsigned char byte3 = static_cast<unsigned char>(str[i + 2]);
-        unsigned char byte4 = static_cast<unsigned char>(str[i + 3]);
-        if ((byte2 & 0xC0) != 0x80 || (byte3 & 0xC0) != 0x80 ||
-            (byte4 & 0xC0) != 0x80) {
-            throw std::runtime_error("Invalid UTF-8");
-        }
-        return {4,
-                static_cast<char32_t>(((byte1 & 0x1F) << 6) | (byte2 & 0x3F))};
-
-    } else {
-        throw std::runtime_error("Invalid UTF-8 start byte");
-    }
-
-    return {0, 0};
+    char32_t code;
+    size_t used = decodeUTF8Step(
+        reinterpret_cast<const unsigned char*>(str.data()) + i,
+        str.size() - i, code);
+    return {used, code};
 }
 
 /**
@@ -181,8 +198,8 @@ struct ColoredChar {
     char32_t c = ' ';                // default: space character
     uint32_t rgba_fg = CCHAR_WHITE;  // default: white opaque
 
-    // TODO: implement background color support
-    uint32_t rgba_bg = CCHAR_BLACK;  // default: black opaque
+    uint32_t rgba_bg = CCHAR_DEFAULT;  // default: terminal background
+    uint8_t attrs = 0;                 // CCHAR_BOLD, CCHAR_ITALIC, ...
 
     ColoredChar() = default;
 
@@ -199,6 +216,19 @@ struct ColoredChar {
     constexpr ColoredChar(char32_t c, uint32_t color = CCHAR_WHITE)
         : c(c), rgba_fg(color) {}
 
+    /**
+     * @brief Constructs a fully styled ColoredChar.
+     *
+     * @param c Unicode code point.
+     * @param fg 32-bit RGBA foreground color.
+     * @param bg 32-bit RGBA background color, transparent keeps the terminal's
+     * background.
+     * @param attributes CCHAR_* attribute bits.
+     */
+    constexpr ColoredChar(char32_t c, uint32_t fg, uint32_t bg,
+                          uint8_t attributes = 0)
+        : c(c), rgba_fg(fg), rgba_bg(bg), attrs(attributes) {}
+
     ColoredChar(const ColoredChar& other) = default;
     ColoredChar& operator=(ColoredChar const& other) = default;
     ColoredChar(ColoredChar&& other) noexcept = default;
@@ -212,6 +242,9 @@ struct ColoredChar {
      * character.
      */
     std::string getCharFGAnsiColor() const {
+        if (isPaletteColor(rgba_fg)) {
+            return "\x1b[38;5;" + std::to_string(paletteIndex(rgba_fg)) + "m";
+        }
         uint8_t r = (rgba_fg >> 24) & 0xFF;
         uint8_t g = (rgba_fg >> 16) & 0xFF;
         uint8_t b = (rgba_fg >> 8) & 0xFF;
@@ -220,21 +253,65 @@ struct ColoredChar {
                ";" + std::to_string(b) + "m";
     }
 
-    // TODO: Implement background color ANSI escape sequence
-    // std::string getCharBGAnsiColor() const {
-    //     uint8_t r = (rgba >> 24) & 0xFF;
-    //     uint8_t g = (rgba >> 16) & 0xFF;
-    //     uint8_t b = (rgba >> 8) & 0xFF;
+    /**
+     * @brief Returns only the ANSI escape sequence for this character's
+     * background color.
+     *
+     * @return std::string The ANSI color prefix, empty if the background is
+     * transparent.
+     */
+    std::string getCharBGAnsiColor() const {
+        if ((rgba_bg & 0xFF) == 0) {
+            return "";
+        }
+        if (isPaletteColor(rgba_bg)) {
+            return "\x1b[48;5;" + std::to_string(paletteIndex(rgba_bg)) + "m";
+        }
+        uint8_t r = (rgba_bg >> 24) & 0xFF;
+        uint8_t g = (rgba_bg >> 16) & 0xFF;
+        uint8_t b = (rgba_bg >> 8) & 0xFF;
+
+        return "\x1b[48;2;" + std::to_string(r) + ";" + std::to_string(g) +
+               ";" + std::to_string(b) + "m";
+    }
 
-    //     return "\x1b[48;2;" + std::to_string(r) + ";" + std::to_string(g) +
-    //            ";" + std::to_string(b) + "m";
-    // }
+    /**
+     * @brief Returns only the ANSI escape sequence for this character's
+     * attributes.
+     *
+     * @return std::string The ANSI attribute prefix, empty if none are set.
+     */
+    std::string getCharAttrAnsi() const {
+        if (attrs == 0) {
+            return "";
+        }
+        static constexpr const char* CODES[] = {"1", "2", "3", "4", "7"};
+        std::string out = "\x1b[";
+        for (size_t bit = 0; bit < 5; ++bit) {
+            if (attrs & (1 << bit)) {
+                if (out.size() > 2) {
+                    out += ';';
+                }
+                out += CODES[bit];
+            }
+        }
+        return out + "m";
+    }
 
     char32_t getRawChar() const { return c; }
 
     std::string getUTF8Char() const { return toUTF8(c); }
 };
 
+inline bool operator==(const ColoredChar& a, const ColoredChar& b) noexcept {
+    return a.c == b.c && a.rgba_fg == b.rgba_fg && a.rgba_bg == b.rgba_bg &&
+           a.attrs == b.attrs;
+}
+
+inline bool operator!=(const ColoredChar& a, const ColoredChar& b) noexcept {
+    return !(a == b);
+}
+
 /**
  * @brief Outstream operator overload for ColoredChar.
  *
@@ -243,11 +320,17 @@ struct ColoredChar {
  * @return std::ostream& output stream
  *
  * @details
- * The output includes the ANSI foreground color sequence, the UTF-8 encoded
- * character, and a reset sequence to restore terminal state.
+ * The output includes the ANSI attribute and color sequences, the UTF-8
+ * encoded character, and a reset sequence to restore terminal state.
+ * Continuation cells print nothing, the wide character before them already
+ * covers them.
  */
 inline std::ostream& operator<<(std::ostream& os, const ColoredChar& cc) {
-    os << cc.getCharFGAnsiColor() << cc.getUTF8Char() << ANSI_RESET;
+    if (cc.c == CCHAR_CONTINUATION) {
+        return os;
+    }
+    os << cc.getCharAttrAnsi() << cc.getCharFGAnsiColor()
+       << cc.getCharBGAnsiColor() << cc.getUTF8Char() << ANSI_RESET;
     return os;
 }
 
@@ -0,0 +1,154 @@
+/**
+ * @file Palette.cpp
+ * @author Amin Karic
+ * @brief Palette implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for Palette class.
+ */
+
+#include "Palette.h"
+
+#include <array>
+#include <cstdlib>
+#include <string>
+
+#include "../ColoredChar.h"
+
+namespace {
+
+// xterm's default system colors
+constexpr uint32_t SYSTEM_COLORS[16] = {
+    0x000000FF, 0xCD0000FF, 0x00CD00FF, 0xCDCD00FF, 0x0000EEFF, 0xCD00CDFF,
+    0x00CDCDFF, 0xE5E5E5FF, 0x7F7F7FFF, 0xFF0000FF, 0x00FF00FF, 0xFFFF00FF,
+    0x5C5CFFFF, 0xFF00FFFF, 0x00FFFFFF, 0xFFFFFFFF};
+
+// Channel values of the 6x6x6 color cube, entries 16 to 231
+constexpr uint8_t CUBE_LEVELS[6] = {0, 95, 135, 175, 215, 255};
+
+constexpr int CUBE_START = 16;
+constexpr int GRAY_START = 232;
+
+// Squared distance weighted roughly by how sensitive the eye is to each
+// channel
+int distance(int r1, int g1, int b1, uint32_t rgba) noexcept {
+    int dr = r1 - static_cast<int>((rgba >> 24) & 0xFF);
+    int dg = g1 - static_cast<int>((rgba >> 16) & 0xFF);
+    int db = b1 - static_cast<int>((rgba >> 8) & 0xFF);
+    return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+// Nearest cube level of a channel, the cube is a grid so each channel can
+// be matched on its own
+int nearestLevel(int v) noexcept {
+    int best = 0;
+    for (int i = 1; i < 6; ++i) {
+        if (std::abs(CUBE_LEVELS[i] - v) < std::abs(CUBE_LEVELS[best] - v)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+using Table = std::array<uint8_t, Palette::TABLE_SIZE>;
+
+Table buildTable(ColorTier tier) {
+    Table table{};
+    for (uint32_t key = 0; key < Palette::TABLE_SIZE; ++key) {
+        // Middle of the colors sharing the key
+        int r = static_cast<int>(((key >> 10) & 0x1F) << 3 | 4);
+        int g = static_cast<int>(((key >> 5) & 0x1F) << 3 | 4);
+        int b = static_cast<int>((key & 0x1F) << 3 | 4);
+
+        int best = 0;
+        int bestDistance = 1 << 30;
+        auto consider = [&](int index) {
+            uint32_t color = Palette::rgba(static_cast<uint8_t>(index));
+            int d = distance(r, g, b, color);
+            if (d < bestDistance) {
+                best = index;
+                bestDistance = d;
+            }
+        };
+        if (tier == ColorTier::Colors16) {
+            for (int i = 0; i < 16; ++i) {
+                consider(i);
+            }
+        } else {
+            consider(CUBE_START + 36 * nearestLevel(r) + 6 * nearestLevel(g) +
+                     nearestLevel(b));
+            for (int i = GRAY_START; i < 256; ++i) {
+                consider(i);
+            }
+        }
+        table[key] = static_cast<uint8_t>(best);
+    }
+    return table;
+}
+
+}  // namespace
+
+ColorTier Palette::detect() {
+    const char* forced = std::getenv("MUSCLI_COLORS");
+    if (forced != nullptr) {
+        std::string value = forced;
+        if (value == "truecolor" || value == "24bit") {
+            return ColorTier::TrueColor;
+        }
+        if (value == "256") {
+            return ColorTier::Colors256;
+        }
+        if (value == "16") {
+            return ColorTier::Colors16;
+        }
+    }
+
+    const char* colorterm = std::getenv("COLORTERM");
+    if (colorterm != nullptr) {
+        std::string value = colorterm;
+        if (value == "truecolor" || value == "24bit") {
+            return ColorTier::TrueColor;
+        }
+    }
+    const char* term = std::getenv("TERM");
+    if (term != nullptr &&
+        std::string(term).find("256color") != std::string::npos) {
+        return ColorTier::Colors256;
+    }
+    return ColorTier::Colors16;
+}
+
+uint32_t Palette::rgba(uint8_t index) noexcept {
+    if (index < CUBE_START) {
+        return SYSTEM_COLORS[index];
+    }
+    if (index < GRAY_START) {
+        int i = index - CUBE_START;
+        return (static_cast<uint32_t>(CUBE_LEVELS[i / 36]) << 24) |
+               (static_cast<uint32_t>(CUBE_LEVELS[i / 6 % 6]) << 16) |
+               (static_cast<uint32_t>(CUBE_LEVELS[i % 6]) << 8) | 0xFF;
+    }
+    uint32_t level = static_cast<uint32_t>(8 + 10 * (index - GRAY_START));
+    return (level << 24) | (level << 16) | (level << 8) | 0xFF;
+}
+
+const uint8_t* Palette::nearestTable(ColorTier tier) {
+    if (tier == ColorTier::Colors16) {
+        static const Table table16 = buildTable(ColorTier::Colors16);
+        return table16.data();
+    }
+    static const Table table256 = buildTable(ColorTier::Colors256);
+    return table256.data();
+}
+
+uint32_t Palette::nearest(ColorTier tier, uint32_t rgba) {
+    if (tier == ColorTier::TrueColor || (rgba & 0xFF) == 0 ||
+        isPaletteColor(rgba)) {
+        return rgba;
+    }
+    uint32_t key = ((rgba >> 17) & 0x7C00) | ((rgba >> 14) & 0x03E0) |
+                   ((rgba >> 11) & 0x001F);
+    return paletteColor(nearestTable(tier)[key]);
+}
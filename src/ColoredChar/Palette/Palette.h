@@ -0,0 +1,74 @@
+/**
+ * @file Palette.h
+ * @author Amin Karic
+ * @brief Palette class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Terminals without truecolor only show the xterm 256 color palette, or
+ * just its first 16 colors, and approximate RGB escapes themselves, often
+ * badly. Palette detects what the terminal supports and maps colors to the
+ * nearest palette entry through a lookup table of 5 bits per channel, so a
+ * color costs one load instead of a search over the palette.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Colors a terminal can show.
+ *
+ * TrueColor: any RGB color
+ * Colors256: the xterm 256 color palette
+ * Colors16: the terminal's 16 system colors
+ */
+enum class ColorTier { TrueColor, Colors256, Colors16 };
+
+/**
+ * @class Palette
+ *
+ * @brief Terminal palette colors and nearest color lookup.
+ */
+class Palette {
+   public:
+    static constexpr uint32_t TABLE_SIZE = 1 << 15;  // 5 bits per channel
+
+    /**
+     * @brief Returns the colors the terminal supports, from the
+     * environment.
+     *
+     * @details MUSCLI_COLORS (truecolor, 256 or 16) overrides the guess made
+     * from COLORTERM and TERM.
+     */
+    static ColorTier detect();
+
+    /**
+     * @brief Returns the RGBA color of a palette entry, as xterm shows it.
+     *
+     * @param index palette index
+     */
+    static uint32_t rgba(uint8_t index) noexcept;
+
+    /**
+     * @brief Returns the nearest palette entry of every 15 bit color.
+     *
+     * @details Indexed by (r >> 3) << 10 | (g >> 3) << 5 | (b >> 3). The
+     * 256 color tier only uses the color cube and gray ramp, whose values
+     * do not depend on the terminal's theme. Built on first use.
+     *
+     * @param tier Colors256 or Colors16
+     * @return const uint8_t* TABLE_SIZE palette indexes
+     */
+    static const uint8_t* nearestTable(ColorTier tier);
+
+    /**
+     * @brief Returns the palette color nearest an RGBA color.
+     *
+     * @param tier colors to choose from, TrueColor returns the color as is
+     * @param rgba color to map, transparent and palette colors are kept
+     * @return uint32_t color made by paletteColor()
+     */
+    static uint32_t nearest(ColorTier tier, uint32_t rgba);
+};
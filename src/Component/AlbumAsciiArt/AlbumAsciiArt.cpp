@@ -9,8 +9,17 @@
  */
 
 #include "AlbumAsciiArt.h"
+#include <algorithm>
+#include <climits>
 #include <cstdint>
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <utility>
+
+#include "GlyphMatcher/GlyphMatcher.h"
+#include "StripDecoder/StripDecoder.h"
+#include "ThumbnailCache/ThumbnailCache.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../../stb/stb_image.h"
@@ -29,65 +38,276 @@ AlbumAsciiArt::AlbumAsciiArt(std::string filepath, int32_t x, int32_t y)
     }
 }
 
-AlbumAsciiArt::AlbumAsciiArt(std::string filepath, int32_t x, int32_t y, uint32_t w, uint32_t h){
-	// TODO: Modify so that dynamic size works with this,
-    content =
-        std::vector<std::vector<ColoredChar>>(15, std::vector<ColoredChar>(30));
+AlbumAsciiArt::AlbumAsciiArt(std::string filepath, int32_t x, int32_t y,
+                             uint32_t w, uint32_t h)
+    : Component(x, y, w, h) {
+    render();
     if (!loadFromFile(filepath)) {
         std::cerr << "Error: Could not load ASCII art from " << filepath
                   << std::endl;
         return;
     }
-};
+}
 
-bool AlbumAsciiArt::loadFromFile(const std::string& filepath) {
-    // We will load the image from a file which we download.
-    // TODO: Regard the previous todo about changing to direct memory loading
-    // We will use stb_image for to resize the image to a 30x15 image.
-    // We then take each pixel and convert it to a colored ASCII character.
-    // The reasoning behind the 30x15 is that our characters are roughly 2:1
-    // height to width ratio, so we want to make it a square.
+AlbumAsciiArt::AlbumAsciiArt(const unsigned char* data, size_t size,
+                             int32_t x, int32_t y)
+    : Component(x, y, 30, 15) {
+    content =
+        std::vector<std::vector<ColoredChar>>(15, std::vector<ColoredChar>(30));
+    if (!loadFromMemory(data, size)) {
+        std::cerr << "Error: Could not load ASCII art from memory"
+                  << std::endl;
+        return;
+    }
+}
 
-    int width, height, channels;
-    unsigned char* data =
-        stbi_load(filepath.data(), &width, &height, &channels, 4);
-    if (!data) {
-        std::cerr << "Error: Failed to load image " << filepath << std::endl;
+bool AlbumAsciiArt::loadFromFile(const std::string& filepath,
+                                 ThumbnailCache* cache, ResizeFilter filter) {
+    std::shared_ptr<const MipChain> chain =
+        decodeFile(filepath, cache, filter);
+    if (!chain) {
+        return false;
+    }
+    setSource(std::move(chain));
+    return true;
+}
+
+bool AlbumAsciiArt::loadFromMemory(const unsigned char* data, size_t size,
+                                   ThumbnailCache* cache,
+                                   ResizeFilter filter) {
+    std::shared_ptr<const MipChain> chain =
+        decodeMemory(data, size, cache, filter);
+    if (!chain) {
         return false;
     }
+    setSource(std::move(chain));
+    return true;
+}
+
+std::shared_ptr<const MipChain> AlbumAsciiArt::decodeFile(
+    const std::string& filepath, ThumbnailCache* cache,
+    ResizeFilter filter) {
+    // The encoded bytes are small next to the decoded image, and reading
+    // them whole lets JPEGs be decoded in strips and the cache hash them
+    std::ifstream file(filepath, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+    if (!file.is_open() || bytes.empty()) {
+        std::cerr << "Error: Failed to load image " << filepath << std::endl;
+        return nullptr;
+    }
+    return decodeMemory(bytes.data(), bytes.size(), cache, filter);
+}
+
+std::shared_ptr<const MipChain> AlbumAsciiArt::decodeMemory(
+    const unsigned char* data, size_t size, ThumbnailCache* cache,
+    ResizeFilter filter) {
+    // stb_image takes the length as an int
+    if (data == nullptr || size == 0 || size > static_cast<size_t>(INT_MAX)) {
+        std::cerr << "Error: Invalid image buffer of " << size << " bytes"
+                  << std::endl;
+        return nullptr;
+    }
+
+    // Art seen before is copied out of the cache without decoding. The
+    // header alone gives the size of the base level it was stored at, and
+    // the filter is part of the key since it changes the stored pixels.
+    MipChain::Level base;
+    uint64_t key = 0;
+    int width, height, channels;
+    bool cacheable = cache != nullptr &&
+                     stbi_info_from_memory(data, static_cast<int>(size),
+                                           &width, &height, &channels);
+    if (cacheable) {
+        MipChain::baseSize(width, height, base.width, base.height);
+        key = ThumbnailCache::hash(data, size, static_cast<uint8_t>(filter));
+        if (cache->lookup(key, size, base.width, base.height, base.rgba)) {
+            return std::make_shared<const MipChain>(std::move(base), filter);
+        }
+    }
+
+    // JPEGs are decoded in strips at a reduced scale when built with
+    // libjpeg, so large covers never exist at full size
+    std::shared_ptr<const MipChain> chain =
+        StripDecoder::decode(data, size, filter);
+    if (!chain) {
+        unsigned char* pixels = stbi_load_from_memory(
+            data, static_cast<int>(size), &width, &height, &channels, 4);
+        if (!pixels) {
+            std::cerr << "Error: Failed to decode image from memory: "
+                      << stbi_failure_reason() << std::endl;
+            return nullptr;
+        }
+        chain = MipChain::fromImage(pixels, width, height, filter);
+        stbi_image_free(pixels);
+    }
+    if (cacheable) {
+        const MipChain::Level& level = chain->base();
+        cache->insert(key, size, level.width, level.height,
+                      level.rgba.data());
+    }
+
+    return chain;
+}
 
-    int outW = 30;
-    int outH = 15;
-    content.resize(static_cast<size_t>(outH));
-    for (auto& row : content) {
-        row.resize(static_cast<size_t>(outW));
+void AlbumAsciiArt::setSource(std::shared_ptr<const MipChain> chain) {
+    source = std::move(chain);
+    render();
+    markDirty();
+    if (onPalette) {
+        onPalette(getDominantColors());
     }
+}
 
-    std::vector<unsigned char> resized(outW * outH * 4);
+const std::vector<uint32_t>& AlbumAsciiArt::getDominantColors()
+    const noexcept {
+    static const std::vector<uint32_t> none;
+    return source ? source->dominantColors() : none;
+}
 
-    stbir_resize_uint8_srgb(data, width, height, 0, resized.data(), outW, outH,
-                            0, STBIR_RGBA);
+void AlbumAsciiArt::setOnPalette(PaletteFn fn) {
+    onPalette = std::move(fn);
+    if (onPalette) {
+        onPalette(getDominantColors());
+    }
+}
+
+void AlbumAsciiArt::setMode(ArtMode m) {
+    if (m == mode) {
+        return;
+    }
+    mode = m;
+    render();
+    markDirty();
+}
+
+void AlbumAsciiArt::setColorTier(ColorTier t) {
+    if (t == tier) {
+        return;
+    }
+    tier = t;
+    render();
+    markDirty();
+}
+
+void AlbumAsciiArt::setDitherMethod(DitherMethod method) {
+    if (method == dither) {
+        return;
+    }
+    dither = method;
+    render();
+    markDirty();
+}
 
-    // Convert each pixel to a ColoredChar
+void AlbumAsciiArt::resize(uint32_t w, uint32_t h) {
+    if (w == getWidth() && h == getHeight() &&
+        content.size() == static_cast<size_t>(h)) {
+        return;
+    }
+    Component::resize(w, h);
+    render();
+    markDirty();
+}
 
-    for (int y = 0; y < outH; ++y) {
-        for (int x = 0; x < outW; ++x) {
-            size_t index = static_cast<size_t>(x + y * outW) * 4;
-            uint8_t r = resized[index];
-            uint8_t g = resized[index + 1];
-            uint8_t b = resized[index + 2];
-            uint8_t a = resized[index + 3];
+void AlbumAsciiArt::render() {
+    size_t w = getWidth();
+    size_t h = getHeight();
+    content.assign(h, std::vector<ColoredChar>(w));
+    if (!source || w == 0 || h == 0) {
+        return;
+    }
 
-            uint32_t color = (static_cast<uint32_t>(r) << 24) |
-                             (static_cast<uint32_t>(g) << 16) |
-                             (static_cast<uint32_t>(b) << 8) |
-                             static_cast<uint32_t>(a);
+    // A cell is about twice as tall as it is wide, so a square image takes
+    // twice as many columns as rows. Fit the image into the component
+    // keeping that shape.
+    const MipChain::Level& base = source->base();
+    double aspect = static_cast<double>(base.width) / base.height;
+    size_t cols = static_cast<size_t>(2.0 * aspect * h + 0.5);
+    size_t rows = h;
+    if (cols > w) {
+        cols = w;
+        rows = static_cast<size_t>(w / (2.0 * aspect) + 0.5);
+    }
+    cols = std::clamp<size_t>(cols, 1, w);
+    rows = std::clamp<size_t>(rows, 1, h);
+    size_t left = (w - cols) / 2;
+    size_t top = (h - rows) / 2;
 
-            content[y][x] = ColoredChar(U'█', color); // Pixel block character
+    if (mode == ArtMode::Quadrant || mode == ArtMode::Braille) {
+        std::shared_ptr<const GlyphMatcher::Cells> cells =
+            GlyphMatcher::shared().match(source,
+                                         mode == ArtMode::Quadrant
+                                             ? GlyphSet::Quadrant
+                                             : GlyphSet::Braille,
+                                         cols, rows);
+        for (size_t y = 0; y < rows; ++y) {
+            std::copy_n(cells->begin() + y * cols, cols,
+                        content[top + y].begin() + left);
+        }
+        if (tier != ColorTier::TrueColor) {
+            // Each cell is already the best pair of colors, dithering
+            // would only add noise
+            for (size_t y = 0; y < rows; ++y) {
+                for (size_t x = 0; x < cols; ++x) {
+                    ColoredChar& cell = content[top + y][left + x];
+                    cell.rgba_fg = Palette::nearest(tier, cell.rgba_fg);
+                    cell.rgba_bg = Palette::nearest(tier, cell.rgba_bg);
+                }
+            }
         }
+        return;
     }
 
-    stbi_image_free(data);
+    // Half blocks show two pixels per cell, one above the other
+    size_t pixelRows = mode == ArtMode::HalfBlock ? rows * 2 : rows;
+    std::vector<unsigned char> resized;
+    std::shared_ptr<const Ditherer::Colors> dithered;
+    if (tier == ColorTier::TrueColor) {
+        source->resample(static_cast<int>(cols), static_cast<int>(pixelRows),
+                         resized);
+    } else {
+        dithered = Ditherer::shared().dither(source, tier, dither, cols,
+                                             pixelRows);
+    }
 
-    return true;
+    auto pixel = [&resized, &dithered, cols](size_t x, size_t y) {
+        if (dithered) {
+            return (*dithered)[x + y * cols];
+        }
+        // Any visible pixel is drawn opaque, the alpha of a cell color
+        // only tells the default and palette colors apart
+        const unsigned char* p = &resized[(x + y * cols) * 4];
+        return (static_cast<uint32_t>(p[0]) << 24) |
+               (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) |
+               (p[3] == 0 ? 0u : 0xFFu);
+    };
+
+    // Convert each pixel, or pair of pixels, to a ColoredChar
+    for (size_t y = 0; y < rows; ++y) {
+        for (size_t x = 0; x < cols; ++x) {
+            ColoredChar& cell = content[top + y][left + x];
+            if (mode == ArtMode::Block) {
+                // Pixel block character, or a blank cell where the pixel is
+                // transparent so the terminal's background shows as it does
+                // in the other modes
+                uint32_t color = pixel(x, y);
+                cell = (color & 0xFF) != 0 ? ColoredChar(U'█', color)
+                                           : ColoredChar(U' ', CCHAR_WHITE);
+                continue;
+            }
+
+            uint32_t upper = pixel(x, 2 * y);
+            uint32_t lower = pixel(x, 2 * y + 1);
+            if ((upper & 0xFF) != 0) {
+                cell = ColoredChar(U'▀', upper, lower);
+            } else if ((lower & 0xFF) != 0) {
+                // A transparent top keeps the terminal's background, which
+                // only the foreground of the lower half block can leave
+                cell = ColoredChar(U'▄', lower);
+            } else {
+                cell = ColoredChar(U' ', CCHAR_WHITE);
+            }
+        }
+    }
 }
@@ -13,35 +13,82 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include "../../ColoredChar/ColoredChar.h"
+#include "../../ColoredChar/Palette/Palette.h"
 #include "../Component.h"
+#include "Ditherer/Ditherer.h"
+#include "MipChain/MipChain.h"
+
+class ThumbnailCache;
+
+/**
+ * @brief How AlbumAsciiArt turns pixels into cells.
+ *
+ * Block: One pixel per cell, drawn as a full block
+ * HalfBlock: Two pixels per cell stacked vertically, drawn as an upper half
+ * block with the top pixel as foreground and the bottom one as background
+ * Quadrant: 2x2 pixels per cell, drawn as the best matching quadrant glyph
+ * and pair of colors
+ * Braille: 2x4 pixels per cell, drawn as the best matching braille pattern
+ * and pair of colors
+ */
+enum class ArtMode { Block, HalfBlock, Quadrant, Braille };
 
 /**
  * @class AlbumAsciiArt
  *
  * @brief Represents an AlbumAsciiArt component.
  *
- * This component renders a fixed-size ASCII representation of album artwork.
+ * This component renders an ASCII representation of album artwork at any
+ * size. Cells are about twice as tall as they are wide, so the art is fitted
+ * into the component keeping its aspect ratio under that 2:1 cell shape and
+ * centered. The decoded image is kept as a MipChain, so resizing resamples a
+ * small copy instead of decoding the image again. On terminals without
+ * truecolor the art is dithered to the palette once per image and size, so
+ * the renderer never has to quantize it.
  */
 class AlbumAsciiArt : public Component {
+   public:
+    using Grid = std::vector<std::vector<ColoredChar>>;  // Rows of pixels
+    using PaletteFn = std::function<void(const std::vector<uint32_t>&)>;
+
    private:
-    std::vector<std::vector<ColoredChar>>
-        content;  // 2D array of ASCII art pixels
+    Grid content;  // 2D array of ASCII art pixels
+    std::shared_ptr<const MipChain> source;  // Decoded image, null if none
+    ArtMode mode = ArtMode::Block;           // Pixels per cell
+    ColorTier tier = ColorTier::TrueColor;   // Colors the terminal shows
+    DitherMethod dither = DitherMethod::Ordered;  // Dithering to the palette
+    PaletteFn onPalette;  // Told the dominant colors of each new image
+
+    /**
+     * @brief Rebuilds the content for the current size from the source.
+     */
+    void render();
 
    public:
     AlbumAsciiArt()
         : Component(0, 0, 30, 15), content(15, std::vector<ColoredChar>(30)){};
 
-    // TODO: Remove the filepath constructors (or keep for testing until ready)
-    // and replace with plain constructors since I'll take in an image straight
-    // from memory using my network class to download the image and load it
-    // straight into memory.
+    /**
+     * @brief Construct a blank Album Ascii Art object, to be filled by
+     * loadFromMemory() or an ArtLoader
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     */
+    AlbumAsciiArt(int32_t x, int32_t y)
+        : Component(x, y, 30, 15), content(15, std::vector<ColoredChar>(30)){};
+
+    // The filepath constructors are kept for testing, artwork from the
+    // network class or from tags is loaded straight from memory.
     /**
      * @brief Construct a new Album Ascii Art object
      *
@@ -57,12 +104,24 @@ class AlbumAsciiArt : public Component {
      * @param filepath file to load ASCII art from
      * @param x x coordinate
      * @param y y coordinate
-     * @param w width
-     * @param h height
+     * @param w width in cells
+     * @param h height in cells
      */
     explicit AlbumAsciiArt(std::string filepath, int32_t x, int32_t y,
                            uint32_t w, uint32_t h);
 
+    /**
+     * @brief Construct a new Album Ascii Art object from an encoded image in
+     * memory
+     *
+     * @param data encoded image bytes (PNG, JPEG, ...)
+     * @param size number of bytes
+     * @param x x coordinate
+     * @param y y coordinate
+     */
+    explicit AlbumAsciiArt(const unsigned char* data, size_t size, int32_t x,
+                           int32_t y);
+
     AlbumAsciiArt(const AlbumAsciiArt& other) = default;
     AlbumAsciiArt& operator=(const AlbumAsciiArt& other) = default;
     AlbumAsciiArt(AlbumAsciiArt&& other) noexcept = default;
@@ -82,10 +141,172 @@ class AlbumAsciiArt : public Component {
      * @brief Load image and create ASCII art from file
      *
      * @param filepath file to load image from
+     * @param cache thumbnail cache to consult and fill, may be null
+     * @param filter filter resizing the image
      * @return true success
      * @return false failure, original content is not modified
      */
-    bool loadFromFile(const std::string& filepath);
+    bool loadFromFile(const std::string& filepath,
+                      ThumbnailCache* cache = nullptr,
+                      ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Load image and create ASCII art from an encoded image in memory
+     *
+     * @param data encoded image bytes (PNG, JPEG, ...), e.g. a downloaded
+     * response body or an embedded tag picture. Only read during the call.
+     * @param size number of bytes
+     * @param cache thumbnail cache to consult and fill, may be null
+     * @param filter filter resizing the image
+     * @return true success
+     * @return false failure, original content is not modified
+     */
+    bool loadFromMemory(const unsigned char* data, size_t size,
+                        ThumbnailCache* cache = nullptr,
+                        ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Load image and create ASCII art from an encoded image in memory
+     *
+     * @param buffer encoded image bytes, only read during the call
+     * @param cache thumbnail cache to consult and fill, may be null
+     * @param filter filter resizing the image
+     * @return true success
+     * @return false failure, original content is not modified
+     */
+    bool loadFromMemory(const std::vector<unsigned char>& buffer,
+                        ThumbnailCache* cache = nullptr,
+                        ResizeFilter filter = ResizeFilter::Area) {
+        return loadFromMemory(buffer.data(), buffer.size(), cache, filter);
+    }
+
+    /**
+     * @brief Decode an image file without touching any component
+     *
+     * @details Safe to call from any thread, used by ArtLoader. The file is
+     * read whole and decoded as by decodeMemory().
+     *
+     * @param filepath file to load image from
+     * @param cache thumbnail cache holding base levels, may be null
+     * @param filter filter resizing the image, kept by the chain
+     * @return std::shared_ptr<const MipChain> decoded image, null on failure
+     */
+    static std::shared_ptr<const MipChain> decodeFile(
+        const std::string& filepath, ThumbnailCache* cache = nullptr,
+        ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Decode an encoded image in memory without touching any
+     * component
+     *
+     * @details Safe to call from any thread, used by ArtLoader. The base
+     * level of the chain is what the cache stores, so a hit skips decoding.
+     *
+     * @param data encoded image bytes (PNG, JPEG, ...)
+     * @param size number of bytes
+     * @param cache thumbnail cache holding base levels, may be null
+     * @param filter filter resizing the image, kept by the chain
+     * @return std::shared_ptr<const MipChain> decoded image, null on failure
+     */
+    static std::shared_ptr<const MipChain> decodeMemory(
+        const unsigned char* data, size_t size,
+        ThumbnailCache* cache = nullptr,
+        ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Show a decoded image and mark the component dirty
+     *
+     * @param chain image from decodeFile() or decodeMemory(), null to clear
+     */
+    void setSource(std::shared_ptr<const MipChain> chain);
+
+    /**
+     * @brief Get the decoded image shown
+     *
+     * @return const std::shared_ptr<const MipChain>& null if none
+     */
+    const std::shared_ptr<const MipChain>& getSource() const noexcept {
+        return source;
+    }
+
+    /**
+     * @brief Get the dominant colors of the image shown
+     *
+     * @return const std::vector<uint32_t>& most common first, empty if no
+     * image is shown
+     */
+    const std::vector<uint32_t>& getDominantColors() const noexcept;
+
+    /**
+     * @brief Set a function told the dominant colors whenever the image
+     * shown changes, to theme other components after the art
+     *
+     * @details Called from setSource(), so on the renderer thread for art
+     * from an ArtLoader, which holds none of its locks during the call: the
+     * function may request or cancel loads. It is called once right away
+     * with the current colors.
+     *
+     * @param fn receives the colors from getDominantColors(), empty when
+     * the art is cleared
+     */
+    void setOnPalette(PaletteFn fn);
+
+    /**
+     * @brief Set how pixels are turned into cells and mark the component
+     * dirty if it changed
+     *
+     * @param m new mode
+     */
+    void setMode(ArtMode m);
+
+    /**
+     * @brief Get how pixels are turned into cells
+     *
+     * @return ArtMode current mode
+     */
+    ArtMode getMode() const noexcept { return mode; }
+
+    /**
+     * @brief Set the colors the terminal shows and mark the component dirty
+     * if they changed
+     *
+     * @details Block and half block art is dithered to the palette, glyph
+     * art takes the nearest palette colors.
+     *
+     * @param t colors the terminal shows, see Palette::detect()
+     */
+    void setColorTier(ColorTier t);
+
+    /**
+     * @brief Get the colors the art is drawn with
+     *
+     * @return ColorTier current tier
+     */
+    ColorTier getColorTier() const noexcept { return tier; }
+
+    /**
+     * @brief Set how block art is dithered to a palette and mark the
+     * component dirty if it changed
+     *
+     * @param method new method
+     */
+    void setDitherMethod(DitherMethod method);
+
+    /**
+     * @brief Get how block art is dithered to a palette
+     *
+     * @return DitherMethod current method
+     */
+    DitherMethod getDitherMethod() const noexcept { return dither; }
+
+    /**
+     * @brief Resizes the art, resampling it from the nearest level of its
+     * chain.
+     *
+     * @param w new width in cells
+     * @param h new height in cells
+     */
+    virtual void resize(uint32_t w, uint32_t h) override;
 
     /**
      * @brief Return the ColoredChar at given pixel coordinates
@@ -104,6 +325,15 @@ class AlbumAsciiArt : public Component {
         return content[static_cast<size_t>(y)][static_cast<size_t>(x)];
     }
 
+    /**
+     * @brief Draws the component into a surface with pixelAt() inlined.
+     *
+     * @param surface surface to draw into
+     */
+    virtual void blit(const Surface& surface) const override final {
+        blitPixels(*this, surface);
+    }
+
     /**
      * @brief Stream insertion operator overload for AlbumAsciiArt. Outputs the
      * art.
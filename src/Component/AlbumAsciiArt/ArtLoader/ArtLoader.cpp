@@ -0,0 +1,144 @@
+/**
+ * @file ArtLoader.cpp
+ * @author Amin Karic
+ * @brief ArtLoader implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for ArtLoader class.
+ */
+
+#include "ArtLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "../../../Renderer/Renderer.h"
+
+ArtLoader::ArtLoader(Renderer& renderer, ThumbnailCache* cache,
+                     ResizeFilter filter)
+    : renderer(renderer),
+      cache(cache),
+      filter(filter),
+      shared(std::make_shared<Shared>()),
+      worker([this] { run(); }) {}
+
+ArtLoader::~ArtLoader() {
+    {
+        std::lock_guard<std::mutex> lock(shared->mtx);
+        shared->stopped = true;
+        pending.clear();
+    }
+    cv.notify_one();
+    worker.join();
+}
+
+void ArtLoader::submit(Job&& job) {
+    {
+        std::lock_guard<std::mutex> lock(shared->mtx);
+        job.generation = nextGeneration++;
+        shared->latest[job.target] = job.generation;
+
+        auto found = std::find_if(
+            pending.begin(), pending.end(),
+            [&job](const Job& other) { return other.target == job.target; });
+        if (found != pending.end()) {
+            *found = std::move(job);
+        } else {
+            pending.push_back(std::move(job));
+        }
+    }
+    cv.notify_one();
+}
+
+void ArtLoader::loadFromFile(AlbumAsciiArt* target, std::string filepath) {
+    submit(Job{target, 0, std::move(filepath), {}});
+}
+
+void ArtLoader::loadFromMemory(AlbumAsciiArt* target,
+                               std::vector<unsigned char> buffer) {
+    submit(Job{target, 0, std::string(), std::move(buffer)});
+}
+
+void ArtLoader::cancel(AlbumAsciiArt* target) {
+    std::unique_lock<std::mutex> lock(shared->mtx);
+    // Art being handed over still uses the component, unless this is called
+    // from the handover itself, e.g. by its palette callback
+    std::thread::id self = std::this_thread::get_id();
+    shared->delivered.wait(lock, [this, target, self] {
+        return shared->delivering != target ||
+               shared->deliveringThread == self;
+    });
+    shared->latest.erase(target);
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [target](const Job& job) {
+                                     return job.target == target;
+                                 }),
+                  pending.end());
+}
+
+void ArtLoader::run() {
+    std::unique_lock<std::mutex> lock(shared->mtx);
+    while (true) {
+        cv.wait(lock, [this] { return shared->stopped || !pending.empty(); });
+        if (shared->stopped) {
+            return;
+        }
+        Job job = std::move(pending.front());
+        pending.erase(pending.begin());
+
+        // Decode unlocked so new requests can supersede this one meanwhile
+        lock.unlock();
+        std::shared_ptr<const MipChain> chain =
+            job.filepath.empty()
+                ? AlbumAsciiArt::decodeMemory(job.buffer.data(),
+                                              job.buffer.size(), cache, filter)
+                : AlbumAsciiArt::decodeFile(job.filepath, cache, filter);
+        job.buffer = std::vector<unsigned char>();
+        lock.lock();
+
+        auto found = shared->latest.find(job.target);
+        if (found == shared->latest.end() ||
+            found->second != job.generation) {
+            continue;  // Superseded or cancelled while decoding
+        }
+        if (!chain) {
+            // Keep showing the previous art
+            shared->latest.erase(found);
+            continue;
+        }
+
+        // The component is only touched on the renderer thread, which draws
+        // it. The request is checked again there as it may have been
+        // superseded in the meantime.
+        lock.unlock();
+        renderer.scheduleOnce(
+            std::chrono::milliseconds(0),
+            [state = shared, target = job.target,
+             generation = job.generation, chain, &renderer = renderer] {
+                {
+                    std::lock_guard<std::mutex> guard(state->mtx);
+                    auto current = state->latest.find(target);
+                    if (state->stopped || current == state->latest.end() ||
+                        current->second != generation) {
+                        return;
+                    }
+                    state->latest.erase(current);
+                    state->delivering = target;
+                    state->deliveringThread = std::this_thread::get_id();
+                }
+                // Unlocked, as the component's palette callback may request
+                // or cancel loads. cancel() waits for this to finish.
+                target->setSource(chain);
+                {
+                    std::lock_guard<std::mutex> guard(state->mtx);
+                    state->delivering = nullptr;
+                }
+                state->delivered.notify_all();
+                renderer.requestPartialRedraw();
+            });
+        lock.lock();
+    }
+}
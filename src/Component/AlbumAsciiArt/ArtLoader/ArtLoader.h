@@ -0,0 +1,161 @@
+/**
+ * @file ArtLoader.h
+ * @author Amin Karic
+ * @brief ArtLoader class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Decoding and downscaling a large cover takes long enough to stall whichever
+ * thread does it. The ArtLoader decodes on a worker thread instead, while the
+ * component keeps showing its previous art, and hands the finished image to
+ * the renderer thread, which swaps it in and redraws the component.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../AlbumAsciiArt.h"
+
+class Renderer;
+class ThumbnailCache;
+
+/**
+ * @class ArtLoader
+ *
+ * @brief Decodes album art in the background.
+ *
+ * @details
+ * Each component has at most one pending request. A new request for the same
+ * component, as when tracks are skipped quickly, replaces the pending one
+ * instead of queueing behind it, and the result of a decode that was already
+ * running is dropped when it finishes. Loads may be requested and cancelled
+ * from any thread.
+ */
+class ArtLoader {
+   private:
+    /**
+     * @brief A request to decode art for a component.
+     */
+    struct Job {
+        AlbumAsciiArt* target;
+        uint64_t generation;               // Matches the latest request
+        std::string filepath;              // Image file, empty for buffer
+        std::vector<unsigned char> buffer; // Encoded image
+    };
+
+    /**
+     * @brief State shared with the callbacks posted to the renderer, which
+     * may run after the loader is destroyed.
+     */
+    struct Shared {
+        std::mutex mtx;  // Protects the members below and the job queue
+        std::unordered_map<AlbumAsciiArt*, uint64_t>
+            latest;            // Generation of the newest request per target
+        bool stopped = false;  // Set when the loader is destroyed
+        AlbumAsciiArt* delivering = nullptr;  // Target given its art now
+        std::thread::id deliveringThread;     // Thread giving it
+        std::condition_variable delivered;    // Woken when that finishes
+    };
+
+    Renderer& renderer;              // Renderer whose thread applies results
+    ThumbnailCache* cache;           // Consulted before decoding, may be null
+    ResizeFilter filter;             // Filter resizing the decoded images
+    std::shared_ptr<Shared> shared;  // Generations and the stop flag
+    std::vector<Job> pending;        // Waiting jobs, one per target
+    std::condition_variable cv;      // Wakes the worker
+    uint64_t nextGeneration = 1;     // Generation of the next request
+    std::thread worker;              // Decodes the pending jobs
+
+    /**
+     * @brief Queues a job, replacing any pending job for the same target.
+     */
+    void submit(Job&& job);
+
+    /**
+     * @brief Worker loop.
+     */
+    void run();
+
+   public:
+    // Requires refrences therefore we cannot have default ctor
+    ArtLoader() = delete;
+
+    /**
+     * @brief Construct a new ArtLoader and start its worker thread
+     *
+     * @param renderer renderer whose thread swaps in the decoded art
+     * @param cache thumbnail cache to consult and fill, may be null. It
+     * must outlive the loader.
+     * @param filter filter resizing the decoded images
+     */
+    explicit ArtLoader(Renderer& renderer, ThumbnailCache* cache = nullptr,
+                       ResizeFilter filter = ResizeFilter::Area);
+
+    // ArtLoader is non-copyable and non-movable, the worker refers to it
+    ArtLoader(const ArtLoader& other) = delete;
+    ArtLoader& operator=(ArtLoader const& other) = delete;
+    ArtLoader(ArtLoader&& other) noexcept = delete;
+    ArtLoader& operator=(ArtLoader&& other) noexcept = delete;
+
+    /**
+     * @brief Stops the worker. Pending loads are dropped and results already
+     * posted to the renderer are not applied.
+     */
+    ~ArtLoader();
+
+    /**
+     * @brief Decode an image file into a component in the background
+     *
+     * @param target component to update, must stay alive until the load
+     * finishes or cancel() is called
+     * @param filepath file to load image from
+     */
+    void loadFromFile(AlbumAsciiArt* target, std::string filepath);
+
+    /**
+     * @brief Decode an encoded image in memory into a component in the
+     * background
+     *
+     * @param target component to update, must stay alive until the load
+     * finishes or cancel() is called
+     * @param buffer encoded image bytes, owned by the loader until decoded
+     */
+    void loadFromMemory(AlbumAsciiArt* target,
+                        std::vector<unsigned char> buffer);
+
+    /**
+     * @brief Decode an encoded image in memory into a component in the
+     * background
+     *
+     * @param target component to update, must stay alive until the load
+     * finishes or cancel() is called
+     * @param data encoded image bytes, copied before returning
+     * @param size number of bytes
+     */
+    void loadFromMemory(AlbumAsciiArt* target, const unsigned char* data,
+                        size_t size) {
+        loadFromMemory(target, std::vector<unsigned char>(data, data + size));
+    }
+
+    /**
+     * @brief Cancel any load for a component. The component keeps its
+     * current art.
+     *
+     * @details If the component is being given its art on another thread,
+     * waits for that to finish, so the component may be destroyed once this
+     * returns.
+     *
+     * @param target component whose load to cancel
+     */
+    void cancel(AlbumAsciiArt* target);
+};
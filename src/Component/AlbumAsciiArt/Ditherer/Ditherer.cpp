@@ -0,0 +1,262 @@
+/**
+ * @file Ditherer.cpp
+ * @author Amin Karic
+ * @brief Ditherer implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for Ditherer class.
+ */
+
+#include "Ditherer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../../../ColoredChar/ColoredChar.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MUSCLI_DITHER_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MUSCLI_DITHER_NEON
+#endif
+
+namespace {
+
+// Bayer threshold matrix, each value is where in 0 to 63 a pixel of the
+// 8x8 tile switches to the next palette entry
+constexpr uint8_t BAYER[8][8] = {
+    {0, 32, 8, 40, 2, 34, 10, 42},  {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44, 4, 36, 14, 46, 6, 38}, {60, 28, 52, 20, 62, 30, 54, 22},
+    {3, 35, 11, 43, 1, 33, 9, 41},  {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47, 7, 39, 13, 45, 5, 37}, {63, 31, 55, 23, 61, 29, 53, 21}};
+
+// Spread of the thresholds, about the distance between neighbouring palette
+// colors: most of the cube's levels are 40 apart, the system colors about
+// 128. Wider spreads than that only add noise.
+int spread(ColorTier tier) noexcept {
+    return tier == ColorTier::Colors16 ? 160 : 48;
+}
+
+/**
+ * @brief Threshold offsets of a Bayer tile as unsigned bytes, split in the
+ * part to add and the part to subtract so saturating byte math can apply
+ * them. Each row repeats its 8 offsets for the R, G and B of a pixel and
+ * leaves the alpha alone.
+ */
+struct Offsets {
+    alignas(16) uint8_t add[8][32];
+    alignas(16) uint8_t sub[8][32];
+};
+
+Offsets makeOffsets(ColorTier tier) noexcept {
+    Offsets t{};
+    int s = spread(tier);
+    for (size_t y = 0; y < 8; ++y) {
+        for (size_t x = 0; x < 8; ++x) {
+            int offset = (2 * BAYER[y][x] + 1) * s / 128 - s / 2;
+            uint8_t up = static_cast<uint8_t>(std::max(offset, 0));
+            uint8_t down = static_cast<uint8_t>(std::max(-offset, 0));
+            for (size_t c = 0; c < 3; ++c) {
+                t.add[y][x * 4 + c] = up;
+                t.sub[y][x * 4 + c] = down;
+            }
+        }
+    }
+    return t;
+}
+
+// Nearest color table key of a pixel
+inline uint32_t keyOf(int r, int g, int b) noexcept {
+    return static_cast<uint32_t>((r >> 3) << 10 | (g >> 3) << 5 | (b >> 3));
+}
+
+// Palette color of a table entry, or the terminal's own for mostly
+// transparent pixels
+inline uint32_t colorOf(const uint8_t* table, uint32_t key,
+                        unsigned char alpha) noexcept {
+    return alpha < 128 ? CCHAR_DEFAULT : paletteColor(table[key]);
+}
+
+}  // namespace
+
+Ditherer::Ditherer(size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {}
+
+void Ditherer::ordered(const unsigned char* rgba, size_t width,
+                       size_t height, ColorTier tier, uint32_t* out) {
+    const uint8_t* table = Palette::nearestTable(tier);
+    Offsets offsets = makeOffsets(tier);
+
+    for (size_t y = 0; y < height; ++y) {
+        const unsigned char* row = rgba + y * width * 4;
+        uint32_t* dst = out + y * width;
+        const uint8_t* add = offsets.add[y & 7];
+        const uint8_t* sub = offsets.sub[y & 7];
+        size_t x = 0;
+
+#if defined(MUSCLI_DITHER_SSE2)
+        // Four pixels at a time: apply the thresholds with saturation, then
+        // gather the top 5 bits of each channel into the 15 bit key. Bytes
+        // load little endian, so red is the lowest byte of each lane.
+        const __m128i redMask = _mm_set1_epi32(0xF8);
+        const __m128i greenMask = _mm_set1_epi32(0xF800);
+        const __m128i blueMask = _mm_set1_epi32(0xF80000);
+        for (; x + 4 <= width; x += 4) {
+            __m128i p =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+            size_t phase = (x & 7) * 4;
+            p = _mm_adds_epu8(p, _mm_load_si128(
+                                     reinterpret_cast<const __m128i*>(
+                                         add + phase)));
+            p = _mm_subs_epu8(p, _mm_load_si128(
+                                     reinterpret_cast<const __m128i*>(
+                                         sub + phase)));
+            __m128i key = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, redMask), 7),
+                             _mm_srli_epi32(_mm_and_si128(p, greenMask), 6)),
+                _mm_srli_epi32(_mm_and_si128(p, blueMask), 19));
+            alignas(16) uint32_t keys[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(keys), key);
+            for (size_t i = 0; i < 4; ++i) {
+                dst[x + i] = colorOf(table, keys[i], row[(x + i) * 4 + 3]);
+            }
+        }
+#elif defined(MUSCLI_DITHER_NEON)
+        const uint32x4_t redMask = vdupq_n_u32(0xF8);
+        const uint32x4_t greenMask = vdupq_n_u32(0xF800);
+        const uint32x4_t blueMask = vdupq_n_u32(0xF80000);
+        for (; x + 4 <= width; x += 4) {
+            uint8x16_t p = vld1q_u8(row + x * 4);
+            size_t phase = (x & 7) * 4;
+            p = vqaddq_u8(p, vld1q_u8(add + phase));
+            p = vqsubq_u8(p, vld1q_u8(sub + phase));
+            uint32x4_t v = vreinterpretq_u32_u8(p);
+            uint32x4_t key = vorrq_u32(
+                vorrq_u32(vshlq_n_u32(vandq_u32(v, redMask), 7),
+                          vshrq_n_u32(vandq_u32(v, greenMask), 6)),
+                vshrq_n_u32(vandq_u32(v, blueMask), 19));
+            uint32_t keys[4];
+            vst1q_u32(keys, key);
+            for (size_t i = 0; i < 4; ++i) {
+                dst[x + i] = colorOf(table, keys[i], row[(x + i) * 4 + 3]);
+            }
+        }
+#endif
+
+        for (; x < width; ++x) {
+            const unsigned char* p = row + x * 4;
+            size_t phase = (x & 7) * 4;
+            int channel[3];
+            for (size_t c = 0; c < 3; ++c) {
+                channel[c] = std::clamp(
+                    p[c] + add[phase + c] - sub[phase + c], 0, 255);
+            }
+            dst[x] = colorOf(table, keyOf(channel[0], channel[1], channel[2]),
+                             p[3]);
+        }
+    }
+}
+
+void Ditherer::diffuse(const unsigned char* rgba, size_t width,
+                       size_t height, ColorTier tier, uint32_t* out) {
+    const uint8_t* table = Palette::nearestTable(tier);
+
+    // Errors carried into the current and the next row, three channels per
+    // pixel with a pixel of padding on each side
+    std::vector<int> current((width + 2) * 3, 0);
+    std::vector<int> next((width + 2) * 3, 0);
+    for (size_t y = 0; y < height; ++y) {
+        const unsigned char* row = rgba + y * width * 4;
+        uint32_t* dst = out + y * width;
+        std::fill(next.begin(), next.end(), 0);
+        for (size_t x = 0; x < width; ++x) {
+            const unsigned char* p = row + x * 4;
+            if (p[3] < 128) {
+                dst[x] = CCHAR_DEFAULT;
+                continue;
+            }
+
+            int* error = &current[(x + 1) * 3];
+            int channel[3];
+            for (size_t c = 0; c < 3; ++c) {
+                // Errors are kept in sixteenths, rounded to nearest
+                int carried = (error[c] + (error[c] < 0 ? -8 : 8)) / 16;
+                channel[c] = std::clamp(p[c] + carried, 0, 255);
+            }
+            uint8_t index =
+                table[keyOf(channel[0], channel[1], channel[2])];
+            dst[x] = paletteColor(index);
+
+            uint32_t shown = Palette::rgba(index);
+            for (size_t c = 0; c < 3; ++c) {
+                int e = channel[c] -
+                        static_cast<int>((shown >> (24 - 8 * c)) & 0xFF);
+                error[3 + c] += e * 7;
+                next[x * 3 + c] += e * 3;
+                next[(x + 1) * 3 + c] += e * 5;
+                next[(x + 2) * 3 + c] += e;
+            }
+        }
+        std::swap(current, next);
+    }
+}
+
+void Ditherer::ditherPixels(const unsigned char* rgba, size_t width,
+                            size_t height, ColorTier tier,
+                            DitherMethod method, uint32_t* out) {
+    if (method == DitherMethod::ErrorDiffusion) {
+        diffuse(rgba, width, height, tier, out);
+    } else {
+        ordered(rgba, width, height, tier, out);
+    }
+}
+
+std::shared_ptr<const Ditherer::Colors> Ditherer::dither(
+    const std::shared_ptr<const MipChain>& source, ColorTier tier,
+    DitherMethod method, size_t width, size_t height) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto it = entries.begin(); it != entries.end();) {
+            std::shared_ptr<const MipChain> held = it->source.lock();
+            if (!held) {
+                // The image was freed, its colors are never used again
+                it = entries.erase(it);
+                continue;
+            }
+            if (held == source && it->tier == tier && it->method == method &&
+                it->width == width && it->height == height) {
+                // Move the hit to the front of the LRU list
+                entries.splice(entries.begin(), entries, it);
+                return it->colors;
+            }
+            ++it;
+        }
+    }
+
+    // Dither without holding the lock, the renderer and loaders may share
+    // the cache
+    std::vector<unsigned char> rgba;
+    source->resample(static_cast<int>(width), static_cast<int>(height), rgba);
+    auto colors = std::make_shared<Colors>(width * height);
+    ditherPixels(rgba.data(), width, height, tier, method, colors->data());
+
+    std::lock_guard<std::mutex> lock(mtx);
+    while (entries.size() >= capacity) {
+        entries.pop_back();
+    }
+    entries.push_front(Entry{source, tier, method, width, height, colors});
+    return colors;
+}
+
+void Ditherer::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+}
+
+Ditherer& Ditherer::shared() {
+    static Ditherer cache;
+    return cache;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file Ditherer.h
+ * @author Amin Karic
+ * @brief Ditherer class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Mapping every pixel of album art to its nearest palette entry turns smooth
+ * gradients into flat bands on terminals with 256 or 16 colors. Dithering
+ * trades the bands for a fine pattern the eye averages back out: ordered
+ * dithering adds a threshold from an 8x8 Bayer matrix to each pixel before
+ * the lookup, error diffusion carries each pixel's error over to its
+ * neighbours (Floyd-Steinberg).
+ *
+ * The ordered kernel works on four pixels at a time with SSE2 or NEON, using
+ * saturating byte adds and the nearest color table of Palette. Results only
+ * depend on the image, the tier, the method and the size, so they are kept
+ * in a small LRU cache next to the image's MipChain and are computed once per
+ * track rather than every frame.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../../ColoredChar/Palette/Palette.h"
+#include "../MipChain/MipChain.h"
+
+/**
+ * @brief How colors between palette entries are approximated.
+ *
+ * Ordered: Bayer matrix thresholds, a stable pattern that is fast to compute
+ * ErrorDiffusion: Floyd-Steinberg, finer detail but one pixel at a time
+ */
+enum class DitherMethod { Ordered, ErrorDiffusion };
+
+/**
+ * @class Ditherer
+ *
+ * @brief Dithers images to a terminal palette, caching the results.
+ */
+class Ditherer {
+   public:
+    using Colors = std::vector<uint32_t>;  // Palette colors, row-major
+
+   private:
+    /**
+     * @brief A dithered image held in the LRU cache.
+     */
+    struct Entry {
+        std::weak_ptr<const MipChain> source;  // Image, expired if freed
+        ColorTier tier;                        // Palette dithered to
+        DitherMethod method;                   // How it was dithered
+        size_t width;                          // Width in pixels
+        size_t height;                         // Height in pixels
+        std::shared_ptr<const Colors> colors;  // Dithered pixels
+    };
+
+    std::mutex mtx;            // Guards the cache
+    size_t capacity;           // Maximum images in the cache
+    std::list<Entry> entries;  // Most recently used first
+
+    /**
+     * @brief Dithers with the Bayer matrix.
+     */
+    static void ordered(const unsigned char* rgba, size_t width,
+                        size_t height, ColorTier tier, uint32_t* out);
+
+    /**
+     * @brief Dithers with Floyd-Steinberg error diffusion.
+     */
+    static void diffuse(const unsigned char* rgba, size_t width,
+                        size_t height, ColorTier tier, uint32_t* out);
+
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 32;  // Dithered images kept
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity maximum number of dithered images kept
+     */
+    explicit Ditherer(size_t capacity = DEFAULT_CAPACITY);
+
+    Ditherer(const Ditherer&) = delete;
+    Ditherer& operator=(const Ditherer&) = delete;
+
+    /**
+     * @brief Dithers an image at a size, or returns the cached result.
+     *
+     * @param source image to dither
+     * @param tier palette to dither to, Colors256 or Colors16
+     * @param method how to dither
+     * @param width width in pixels
+     * @param height height in pixels
+     * @return std::shared_ptr<const Colors> width * height colors
+     */
+    std::shared_ptr<const Colors> dither(
+        const std::shared_ptr<const MipChain>& source, ColorTier tier,
+        DitherMethod method, size_t width, size_t height);
+
+    /**
+     * @brief Dithers pixels without caching.
+     *
+     * @param rgba width * height pixels, 4 bytes each
+     * @param width width in pixels
+     * @param height height in pixels
+     * @param tier palette to dither to, Colors256 or Colors16
+     * @param method how to dither
+     * @param out receives paletteColor() entries, CCHAR_DEFAULT for mostly
+     * transparent pixels
+     */
+    static void ditherPixels(const unsigned char* rgba, size_t width,
+                             size_t height, ColorTier tier,
+                             DitherMethod method, uint32_t* out);
+
+    /**
+     * @brief Drops every cached image.
+     */
+    void clear();
+
+    /**
+     * @brief Cache shared by the components.
+     */
+    static Ditherer& shared();
+};
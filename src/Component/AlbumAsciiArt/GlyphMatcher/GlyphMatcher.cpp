@@ -0,0 +1,355 @@
+/**
+ * @file GlyphMatcher.cpp
+ * @author Amin Karic
+ * @brief GlyphMatcher implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for GlyphMatcher class.
+ */
+
+#include "GlyphMatcher.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MUSCLI_GLYPH_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MUSCLI_GLYPH_NEON
+#endif
+
+namespace {
+
+constexpr size_t MAX_PIXELS = 8;                // Pixels in a braille cell
+constexpr size_t MAX_SPLITS = 1 << MAX_PIXELS;  // Splits of a braille cell
+
+// Quadrant glyphs indexed by their filled quarters: bit 0 is the top left,
+// bit 1 the top right, bit 2 the bottom left and bit 3 the bottom right
+constexpr char32_t QUADRANTS[16] = {U' ', U'▘', U'▝', U'▀', U'▖', U'▌',
+                                    U'▞', U'▛', U'▗', U'▚', U'▐', U'▜',
+                                    U'▄', U'▙', U'▟', U'█'};
+
+// Pixel of each braille dot, in the bit order of U+2800 + dots
+constexpr uint8_t BRAILLE_X[MAX_PIXELS] = {0, 0, 0, 1, 1, 1, 0, 1};
+constexpr uint8_t BRAILLE_Y[MAX_PIXELS] = {0, 1, 2, 0, 1, 2, 3, 3};
+
+/**
+ * @brief Reciprocal of the pixel count on each side of every split.
+ */
+struct Reciprocals {
+    // 1 / pixels in the foreground, 0 for none
+    alignas(16) float inside[MAX_SPLITS];
+    // 1 / pixels in the background of a 4 and an 8 pixel cell, 0 for none
+    alignas(16) float outside4[16];
+    alignas(16) float outside8[MAX_SPLITS];
+};
+
+constexpr Reciprocals makeReciprocals() {
+    Reciprocals t{};
+    for (size_t m = 0; m < MAX_SPLITS; ++m) {
+        int n = 0;
+        for (size_t bit = 0; bit < MAX_PIXELS; ++bit) {
+            n += (m >> bit) & 1;
+        }
+        t.inside[m] = n == 0 ? 0.0f : 1.0f / n;
+        t.outside8[m] = n == 8 ? 0.0f : 1.0f / (8 - n);
+        if (m < 16) {
+            t.outside4[m] = n == 4 ? 0.0f : 1.0f / (4 - n);
+        }
+    }
+    return t;
+}
+
+constexpr Reciprocals RECIPROCALS = makeReciprocals();
+
+/**
+ * @brief Channel sums of every split of a cell, one array per channel.
+ */
+struct Sums {
+    alignas(16) float r[MAX_SPLITS];
+    alignas(16) float g[MAX_SPLITS];
+    alignas(16) float b[MAX_SPLITS];
+    alignas(16) float a[MAX_SPLITS];
+};
+
+/**
+ * @brief Returns the split with the highest score.
+ *
+ * @param s sums of every split, the last one being the whole cell
+ * @param splits number of splits, a multiple of 4
+ * @param outside reciprocals of the background counts
+ */
+inline size_t bestSplit(const Sums& s, size_t splits,
+                        const float* outside) noexcept {
+    const float* inside = RECIPROCALS.inside;
+    size_t whole = splits - 1;
+#if defined(MUSCLI_GLYPH_SSE2)
+    __m128 tr = _mm_set1_ps(s.r[whole]);
+    __m128 tg = _mm_set1_ps(s.g[whole]);
+    __m128 tb = _mm_set1_ps(s.b[whole]);
+    __m128 ta = _mm_set1_ps(s.a[whole]);
+    __m128 best = _mm_set1_ps(-1.0f);
+    __m128i bestIndex = _mm_setzero_si128();
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i step = _mm_set1_epi32(4);
+    for (size_t m = 0; m < splits; m += 4) {
+        __m128 r = _mm_load_ps(s.r + m);
+        __m128 g = _mm_load_ps(s.g + m);
+        __m128 b = _mm_load_ps(s.b + m);
+        __m128 a = _mm_load_ps(s.a + m);
+        __m128 in = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(g, g)),
+            _mm_add_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, a)));
+        r = _mm_sub_ps(tr, r);
+        g = _mm_sub_ps(tg, g);
+        b = _mm_sub_ps(tb, b);
+        a = _mm_sub_ps(ta, a);
+        __m128 out = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(g, g)),
+            _mm_add_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, a)));
+        __m128 score =
+            _mm_add_ps(_mm_mul_ps(in, _mm_load_ps(inside + m)),
+                       _mm_mul_ps(out, _mm_load_ps(outside + m)));
+
+        __m128 better = _mm_cmpgt_ps(score, best);
+        __m128i mask = _mm_castps_si128(better);
+        best = _mm_or_ps(_mm_and_ps(better, score),
+                         _mm_andnot_ps(better, best));
+        bestIndex = _mm_or_si128(_mm_and_si128(mask, index),
+                                 _mm_andnot_si128(mask, bestIndex));
+        index = _mm_add_epi32(index, step);
+    }
+    alignas(16) float scores[4];
+    alignas(16) int32_t indexes[4];
+    _mm_store_ps(scores, best);
+    _mm_store_si128(reinterpret_cast<__m128i*>(indexes), bestIndex);
+#elif defined(MUSCLI_GLYPH_NEON)
+    float32x4_t tr = vdupq_n_f32(s.r[whole]);
+    float32x4_t tg = vdupq_n_f32(s.g[whole]);
+    float32x4_t tb = vdupq_n_f32(s.b[whole]);
+    float32x4_t ta = vdupq_n_f32(s.a[whole]);
+    float32x4_t best = vdupq_n_f32(-1.0f);
+    uint32x4_t bestIndex = vdupq_n_u32(0);
+    const uint32_t first[4] = {0, 1, 2, 3};
+    uint32x4_t index = vld1q_u32(first);
+    uint32x4_t step = vdupq_n_u32(4);
+    for (size_t m = 0; m < splits; m += 4) {
+        float32x4_t r = vld1q_f32(s.r + m);
+        float32x4_t g = vld1q_f32(s.g + m);
+        float32x4_t b = vld1q_f32(s.b + m);
+        float32x4_t a = vld1q_f32(s.a + m);
+        float32x4_t in = vmulq_f32(r, r);
+        in = vmlaq_f32(in, g, g);
+        in = vmlaq_f32(in, b, b);
+        in = vmlaq_f32(in, a, a);
+        r = vsubq_f32(tr, r);
+        g = vsubq_f32(tg, g);
+        b = vsubq_f32(tb, b);
+        a = vsubq_f32(ta, a);
+        float32x4_t out = vmulq_f32(r, r);
+        out = vmlaq_f32(out, g, g);
+        out = vmlaq_f32(out, b, b);
+        out = vmlaq_f32(out, a, a);
+        float32x4_t score = vmlaq_f32(vmulq_f32(in, vld1q_f32(inside + m)),
+                                      out, vld1q_f32(outside + m));
+
+        uint32x4_t better = vcgtq_f32(score, best);
+        best = vbslq_f32(better, score, best);
+        bestIndex = vbslq_u32(better, index, bestIndex);
+        index = vaddq_u32(index, step);
+    }
+    float scores[4];
+    uint32_t indexes[4];
+    vst1q_f32(scores, best);
+    vst1q_u32(indexes, bestIndex);
+#else
+    float scores[4] = {-1.0f, -1.0f, -1.0f, -1.0f};
+    size_t indexes[4] = {0, 0, 0, 0};
+    for (size_t m = 0; m < splits; ++m) {
+        float r = s.r[m], g = s.g[m], b = s.b[m], a = s.a[m];
+        float in = r * r + g * g + b * b + a * a;
+        r = s.r[whole] - r;
+        g = s.g[whole] - g;
+        b = s.b[whole] - b;
+        a = s.a[whole] - a;
+        float out = r * r + g * g + b * b + a * a;
+        float score = in * inside[m] + out * outside[m];
+        if (score > scores[m & 3]) {
+            scores[m & 3] = score;
+            indexes[m & 3] = m;
+        }
+    }
+#endif
+
+    // Ties go to the lowest split, whichever lane found it
+    size_t lane = 0;
+    for (size_t i = 1; i < 4; ++i) {
+        if (scores[i] > scores[lane] ||
+            (scores[i] == scores[lane] && indexes[i] < indexes[lane])) {
+            lane = i;
+        }
+    }
+    return static_cast<size_t>(indexes[lane]);
+}
+
+// Mean color of a sum of pixels, opaque unless mostly transparent
+uint32_t meanColor(const Sums& s, size_t m, float reciprocal) noexcept {
+    auto channel = [reciprocal](float sum) {
+        return static_cast<uint32_t>(sum * reciprocal + 0.5f);
+    };
+    if (channel(s.a[m]) < 128) {
+        return CCHAR_DEFAULT;
+    }
+    return (channel(s.r[m]) << 24) | (channel(s.g[m]) << 16) |
+           (channel(s.b[m]) << 8) | 0xFF;
+}
+
+}  // namespace
+
+GlyphMatcher::GlyphMatcher(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)) {}
+
+void GlyphMatcher::cellPixels(GlyphSet set, size_t& w, size_t& h) noexcept {
+    w = 2;
+    h = set == GlyphSet::Braille ? 4 : 2;
+}
+
+void GlyphMatcher::matchRows(const unsigned char* rgba, GlyphSet set,
+                             size_t cols, size_t firstRow, size_t lastRow,
+                             ColoredChar* cells) noexcept {
+    bool braille = set == GlyphSet::Braille;
+    size_t pixels = braille ? 8 : 4;
+    size_t splits = size_t{1} << pixels;
+    size_t whole = splits - 1;
+    const float* outside =
+        braille ? RECIPROCALS.outside8 : RECIPROCALS.outside4;
+    size_t cellH = braille ? 4 : 2;
+    size_t stride = cols * 2 * 4;  // Bytes per pixel row
+
+    Sums s;
+    s.r[0] = s.g[0] = s.b[0] = s.a[0] = 0.0f;
+    for (size_t row = firstRow; row < lastRow; ++row) {
+        for (size_t col = 0; col < cols; ++col) {
+            // Sums of every split, adding one pixel at a time: the splits
+            // containing pixel i are those without it plus the pixel
+            for (size_t i = 0; i < pixels; ++i) {
+                size_t x = braille ? BRAILLE_X[i] : (i & 1);
+                size_t y = braille ? BRAILLE_Y[i] : (i >> 1);
+                const unsigned char* p =
+                    rgba + (row * cellH + y) * stride + (col * 2 + x) * 4;
+                float r = p[0], g = p[1], b = p[2], a = p[3];
+                size_t half = size_t{1} << i;
+                for (size_t m = 0; m < half; ++m) {
+                    s.r[half + m] = s.r[m] + r;
+                    s.g[half + m] = s.g[m] + g;
+                    s.b[half + m] = s.b[m] + b;
+                    s.a[half + m] = s.a[m] + a;
+                }
+            }
+
+            size_t m = bestSplit(s, splits, outside);
+            ColoredChar& cell = cells[row * cols + col];
+            if (m == 0 || m == whole) {
+                // One color, a space shows it in full with either set
+                cell = ColoredChar(U' ', CCHAR_WHITE,
+                                   meanColor(s, whole, 1.0f / pixels));
+                continue;
+            }
+
+            uint32_t fg = meanColor(s, m, RECIPROCALS.inside[m]);
+            uint32_t bg = meanColor(s, whole ^ m, RECIPROCALS.inside[whole ^ m]);
+            if (fg == CCHAR_DEFAULT) {
+                // Only a background can be left transparent, so draw the
+                // other side of the split instead
+                m ^= whole;
+                fg = bg;
+                bg = CCHAR_DEFAULT;
+            }
+            if (fg == CCHAR_DEFAULT) {
+                cell = ColoredChar(U' ', CCHAR_WHITE);
+                continue;
+            }
+            char32_t glyph = braille ? static_cast<char32_t>(0x2800 + m)
+                                     : QUADRANTS[m];
+            cell = ColoredChar(glyph, fg, bg);
+        }
+    }
+}
+
+void GlyphMatcher::matchPixels(const unsigned char* rgba, GlyphSet set,
+                               size_t cols, size_t rows, ColoredChar* cells) {
+    size_t threads = 1;
+    if (cols * rows >= PARALLEL_CELLS) {
+        threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                     rows);
+    }
+
+    // Bands of rows, the first one matched on this thread
+    size_t band = (rows + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (size_t first = band; first < rows; first += band) {
+        size_t last = std::min(first + band, rows);
+        workers.emplace_back([=] {
+            matchRows(rgba, set, cols, first, last, cells);
+        });
+    }
+    matchRows(rgba, set, cols, 0, std::min(band, rows), cells);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::shared_ptr<const GlyphMatcher::Cells> GlyphMatcher::match(
+    const std::shared_ptr<const MipChain>& source, GlyphSet set, size_t cols,
+    size_t rows) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto it = entries.begin(); it != entries.end();) {
+            std::shared_ptr<const MipChain> held = it->source.lock();
+            if (!held) {
+                // The image was freed, its cells are never used again
+                it = entries.erase(it);
+                continue;
+            }
+            if (held == source && it->set == set && it->cols == cols &&
+                it->rows == rows) {
+                // Move the hit to the front of the LRU list
+                entries.splice(entries.begin(), entries, it);
+                return it->cells;
+            }
+            ++it;
+        }
+    }
+
+    // Match without holding the lock, the renderer and loaders may share
+    // the cache
+    size_t cellW, cellH;
+    cellPixels(set, cellW, cellH);
+    std::vector<unsigned char> rgba;
+    source->resample(static_cast<int>(cols * cellW),
+                     static_cast<int>(rows * cellH), rgba);
+    auto cells = std::make_shared<Cells>(cols * rows);
+    matchPixels(rgba.data(), set, cols, rows, cells->data());
+
+    std::lock_guard<std::mutex> lock(mtx);
+    while (entries.size() >= capacity) {
+        entries.pop_back();
+    }
+    entries.push_front(Entry{source, set, cols, rows, cells});
+    return cells;
+}
+
+void GlyphMatcher::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+}
+
+GlyphMatcher& GlyphMatcher::shared() {
+    static GlyphMatcher cache;
+    return cache;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file GlyphMatcher.h
+ * @author Amin Karic
+ * @brief GlyphMatcher class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Quadrant glyphs split a cell into 2x2 pixels and braille glyphs into 2x4,
+ * so art drawn with them shows two or four times the detail of half blocks.
+ * A cell still only has two colors, so each one is a small search: every
+ * glyph splits the cell's pixels into a foreground and a background set, each
+ * set is painted its mean color, and the glyph with the least squared error
+ * wins.
+ *
+ * Minimising the error of a split is the same as maximising
+ * |S|^2 / n + |T - S|^2 / (k - n), where S is the sum of the n pixels in the
+ * foreground, T the sum of all k pixels. The sums of every split are built by
+ * doubling, one pixel at a time, and the scores are compared four splits at
+ * a time with SSE2 or NEON. Large art is split into bands of rows matched on
+ * separate threads.
+ *
+ * The search only depends on the image and the size, so results are kept in
+ * a small LRU cache next to the image's MipChain and a resize back to a
+ * previous size, or a switch between modes, does not search again.
+ */
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../../ColoredChar/ColoredChar.h"
+#include "../MipChain/MipChain.h"
+
+/**
+ * @brief Glyphs a cell is matched against.
+ *
+ * Quadrant: 2x2 pixels per cell, the 16 quadrant block elements
+ * Braille: 2x4 pixels per cell, the 256 braille patterns
+ */
+enum class GlyphSet { Quadrant, Braille };
+
+/**
+ * @class GlyphMatcher
+ *
+ * @brief Matches cells of an image to two-color glyphs, caching the results.
+ */
+class GlyphMatcher {
+   public:
+    using Cells = std::vector<ColoredChar>;  // Matched cells, row-major
+
+   private:
+    /**
+     * @brief A matched image held in the LRU cache.
+     */
+    struct Entry {
+        std::weak_ptr<const MipChain> source;  // Image, expired if freed
+        GlyphSet set;                          // Glyphs matched against
+        size_t cols;                           // Width in cells
+        size_t rows;                           // Height in cells
+        std::shared_ptr<const Cells> cells;    // Matched cells
+    };
+
+    std::mutex mtx;            // Guards the cache
+    size_t capacity;           // Maximum images in the cache
+    std::list<Entry> entries;  // Most recently used first
+
+    /**
+     * @brief Matches a band of cell rows.
+     */
+    static void matchRows(const unsigned char* rgba, GlyphSet set,
+                          size_t cols, size_t firstRow, size_t lastRow,
+                          ColoredChar* cells) noexcept;
+
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 32;  // Matched images kept
+    static constexpr size_t PARALLEL_CELLS = 4096;  // Cells before threading
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity maximum number of matched images kept
+     */
+    explicit GlyphMatcher(size_t capacity = DEFAULT_CAPACITY);
+
+    GlyphMatcher(const GlyphMatcher&) = delete;
+    GlyphMatcher& operator=(const GlyphMatcher&) = delete;
+
+    /**
+     * @brief Returns the horizontal and vertical pixels per cell of a set.
+     */
+    static void cellPixels(GlyphSet set, size_t& w, size_t& h) noexcept;
+
+    /**
+     * @brief Matches an image at a size, or returns the cached result.
+     *
+     * @param source image to match
+     * @param set glyphs to match against
+     * @param cols width in cells
+     * @param rows height in cells
+     * @return std::shared_ptr<const Cells> cols * rows cells
+     */
+    std::shared_ptr<const Cells> match(
+        const std::shared_ptr<const MipChain>& source, GlyphSet set,
+        size_t cols, size_t rows);
+
+    /**
+     * @brief Matches pixels to cells without caching.
+     *
+     * @param rgba pixels of the cells, cellPixels() per cell, 4 bytes each
+     * @param set glyphs to match against
+     * @param cols width in cells
+     * @param rows height in cells
+     * @param cells receives cols * rows cells
+     */
+    static void matchPixels(const unsigned char* rgba, GlyphSet set,
+                            size_t cols, size_t rows, ColoredChar* cells);
+
+    /**
+     * @brief Drops every cached image.
+     */
+    void clear();
+
+    /**
+     * @brief Cache shared by the components.
+     */
+    static GlyphMatcher& shared();
+};
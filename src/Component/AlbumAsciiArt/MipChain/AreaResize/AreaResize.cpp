@@ -0,0 +1,292 @@
+/**
+ * @file AreaResize.cpp
+ * @author Amin Karic
+ * @brief Gamma-correct area downscaling implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "AreaResize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MUSCLI_AREA_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MUSCLI_AREA_NEON
+#endif
+
+namespace {
+
+constexpr size_t LINEAR_STEPS = 16384;  // Entries of the linear to sRGB table
+
+/**
+ * @brief Conversion tables between sRGB bytes and linear light.
+ */
+struct Gamma {
+    float toLinear[256];                   // sRGB byte to linear 0..1
+    unsigned char toSRGB[LINEAR_STEPS + 1];  // Linear step to sRGB byte
+
+    Gamma() {
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            toLinear[i] = c <= 0.04045f
+                              ? c / 12.92f
+                              : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (size_t i = 0; i <= LINEAR_STEPS; ++i) {
+            float l = static_cast<float>(i) / LINEAR_STEPS;
+            float c = l <= 0.0031308f
+                          ? l * 12.92f
+                          : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSRGB[i] = static_cast<unsigned char>(c * 255.0f + 0.5f);
+        }
+    }
+};
+
+const Gamma& gamma() {
+    static const Gamma tables;
+    return tables;
+}
+
+// A pixel in linear light with premultiplied alpha, as r, g, b, a
+#if defined(MUSCLI_AREA_SSE2)
+using Pixel = __m128;
+inline Pixel zero() noexcept { return _mm_setzero_ps(); }
+inline Pixel make(float r, float g, float b, float a) noexcept {
+    return _mm_setr_ps(r, g, b, a);
+}
+inline Pixel load(const float* p) noexcept { return _mm_loadu_ps(p); }
+inline void store(float* p, Pixel v) noexcept { _mm_storeu_ps(p, v); }
+inline Pixel add(Pixel a, Pixel b) noexcept { return _mm_add_ps(a, b); }
+inline Pixel scale(Pixel a, float s) noexcept {
+    return _mm_mul_ps(a, _mm_set1_ps(s));
+}
+#elif defined(MUSCLI_AREA_NEON)
+using Pixel = float32x4_t;
+inline Pixel zero() noexcept { return vdupq_n_f32(0.0f); }
+inline Pixel make(float r, float g, float b, float a) noexcept {
+    const float v[4] = {r, g, b, a};
+    return vld1q_f32(v);
+}
+inline Pixel load(const float* p) noexcept { return vld1q_f32(p); }
+inline void store(float* p, Pixel v) noexcept { vst1q_f32(p, v); }
+inline Pixel add(Pixel a, Pixel b) noexcept { return vaddq_f32(a, b); }
+inline Pixel scale(Pixel a, float s) noexcept { return vmulq_n_f32(a, s); }
+#else
+struct Pixel {
+    float v[4];
+};
+inline Pixel zero() noexcept { return Pixel{{0.0f, 0.0f, 0.0f, 0.0f}}; }
+inline Pixel make(float r, float g, float b, float a) noexcept {
+    return Pixel{{r, g, b, a}};
+}
+inline Pixel load(const float* p) noexcept {
+    return Pixel{{p[0], p[1], p[2], p[3]}};
+}
+inline void store(float* p, Pixel v) noexcept {
+    std::copy(v.v, v.v + 4, p);
+}
+inline Pixel add(Pixel a, Pixel b) noexcept {
+    return Pixel{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2],
+                  a.v[3] + b.v[3]}};
+}
+inline Pixel scale(Pixel a, float s) noexcept {
+    return Pixel{{a.v[0] * s, a.v[1] * s, a.v[2] * s, a.v[3] * s}};
+}
+#endif
+
+/**
+ * @brief Source pixels averaged into one output pixel along an axis.
+ */
+struct Span {
+    int first;      // First source pixel
+    int count;      // Number of source pixels
+    size_t weight;  // Index of the first weight
+};
+
+/**
+ * @brief Computes the spans and weights of an area filter along an axis.
+ *
+ * @details Output pixel i covers [i * in / out, (i + 1) * in / out) of the
+ * source, and each source pixel is weighted by how much of it is covered.
+ * The weights of a span add up to 1.
+ */
+void areaSpans(int in, int out, std::vector<Span>& spans,
+               std::vector<float>& weights) {
+    double ratio = static_cast<double>(in) / out;
+    spans.resize(static_cast<size_t>(out));
+    weights.clear();
+    for (int i = 0; i < out; ++i) {
+        double start = i * ratio;
+        double end = std::min((i + 1) * ratio, static_cast<double>(in));
+        int first = static_cast<int>(start);
+        int last = std::min(static_cast<int>(std::ceil(end)), in);
+        spans[i] = Span{first, last - first, weights.size()};
+        for (int s = first; s < last; ++s) {
+            double covered = std::min(end, s + 1.0) - std::max(start,
+                                                               double(s));
+            weights.push_back(static_cast<float>(covered / ratio));
+        }
+    }
+}
+
+// Converts a linear premultiplied pixel back to straight sRGB bytes
+void toSRGB(const float* p, unsigned char* out) noexcept {
+    const unsigned char* table = gamma().toSRGB;
+    float a = p[3];
+    if (a <= 0.0f) {
+        std::fill(out, out + 4, 0);
+        return;
+    }
+    float unpremultiply = LINEAR_STEPS / a;
+    for (int c = 0; c < 3; ++c) {
+        float step = std::min(p[c] * unpremultiply,
+                              static_cast<float>(LINEAR_STEPS));
+        out[c] = table[static_cast<size_t>(step + 0.5f)];
+    }
+    out[3] = static_cast<unsigned char>(std::min(a, 1.0f) * 255.0f + 0.5f);
+}
+
+}  // namespace
+
+BoxReducer::BoxReducer(int width, int height, int reducedW, int reducedH)
+    : width(width),
+      height(height),
+      reducedW(reducedW),
+      reducedH(reducedH),
+      edges(static_cast<size_t>(reducedW) + 1),
+      sums(static_cast<size_t>(reducedW) * 4, 0.0f),
+      reduced(static_cast<size_t>(reducedW) * reducedH * 4) {
+    for (int i = 0; i <= reducedW; ++i) {
+        edges[i] = static_cast<int>(static_cast<long long>(i) * width /
+                                    reducedW);
+    }
+    bandBottom = bandEdge(1);
+}
+
+int BoxReducer::bandEdge(int index) const noexcept {
+    return static_cast<int>(static_cast<long long>(index) * height /
+                            reducedH);
+}
+
+void BoxReducer::addRows(const unsigned char* rows, size_t stride, int count,
+                         int channels) {
+    const float* toLinear = gamma().toLinear;
+    for (int r = 0; r < count && band < reducedH; ++r) {
+        // Each row adds to the sums of its boxes in the current band
+        const unsigned char* row = rows + static_cast<size_t>(r) * stride;
+        for (int i = 0; i < reducedW; ++i) {
+            Pixel sum = zero();
+            const unsigned char* p =
+                row + static_cast<size_t>(edges[i]) * channels;
+            for (int x = edges[i]; x < edges[i + 1]; ++x, p += channels) {
+                Pixel linear = make(toLinear[p[0]], toLinear[p[1]],
+                                    toLinear[p[2]], 1.0f);
+                // Opaque pixels, most of any cover, skip the multiply
+                sum = add(sum, channels == 3 || p[3] == 255
+                                   ? linear
+                                   : scale(linear, p[3] / 255.0f));
+            }
+            float* acc = &sums[static_cast<size_t>(i) * 4];
+            store(acc, add(load(acc), sum));
+        }
+
+        if (++nextRow < bandBottom) {
+            continue;
+        }
+        // The band is complete, average its boxes
+        int bandRows = bandBottom - bandEdge(band);
+        float* dst = &reduced[static_cast<size_t>(band) * reducedW * 4];
+        for (int i = 0; i < reducedW; ++i) {
+            float pixels = static_cast<float>(edges[i + 1] - edges[i]) *
+                           static_cast<float>(bandRows);
+            float* acc = &sums[static_cast<size_t>(i) * 4];
+            store(dst + static_cast<size_t>(i) * 4,
+                  scale(load(acc), 1.0f / pixels));
+        }
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        ++band;
+        bandBottom = bandEdge(band + 1);
+    }
+}
+
+void BoxReducer::finish(unsigned char* out, int outW, int outH) const {
+    if (outW == reducedW && outH == reducedH) {
+        for (size_t i = 0; i < static_cast<size_t>(outW) * outH; ++i) {
+            toSRGB(&reduced[i * 4], out + i * 4);
+        }
+        return;
+    }
+
+    // Horizontal then vertical area filter
+    std::vector<Span> spans;
+    std::vector<float> weights;
+    areaSpans(reducedW, outW, spans, weights);
+    std::vector<float> columns(static_cast<size_t>(outW) * reducedH * 4);
+    for (int y = 0; y < reducedH; ++y) {
+        const float* src = &reduced[static_cast<size_t>(y) * reducedW * 4];
+        float* dst = &columns[static_cast<size_t>(y) * outW * 4];
+        for (int x = 0; x < outW; ++x) {
+            const Span& span = spans[x];
+            Pixel sum = zero();
+            for (int s = 0; s < span.count; ++s) {
+                sum = add(sum,
+                          scale(load(src + static_cast<size_t>(span.first + s) *
+                                               4),
+                                weights[span.weight + s]));
+            }
+            store(dst + static_cast<size_t>(x) * 4, sum);
+        }
+    }
+
+    areaSpans(reducedH, outH, spans, weights);
+    for (int y = 0; y < outH; ++y) {
+        const Span& span = spans[y];
+        for (int x = 0; x < outW; ++x) {
+            Pixel sum = zero();
+            for (int s = 0; s < span.count; ++s) {
+                const float* src =
+                    &columns[(static_cast<size_t>(span.first + s) * outW + x) *
+                             4];
+                sum = add(sum, scale(load(src), weights[span.weight + s]));
+            }
+            float result[4];
+            store(result, sum);
+            toSRGB(result,
+                   out + (static_cast<size_t>(y) * outW + x) * 4);
+        }
+    }
+}
+
+void BoxReducer::reducedSize(int width, int height, int outW, int outH,
+                             int& reducedW, int& reducedH) noexcept {
+    if (width % outW == 0 && height % outH == 0) {
+        // Whole ratios, such as the halvings of a MipChain, are just boxes
+        reducedW = outW;
+        reducedH = outH;
+        return;
+    }
+    // Boxes alone would leave up to a whole source pixel of error at each
+    // output edge, so stop at twice the output size and let the area filter
+    // place the edges exactly
+    reducedW = std::min(width, outW * 2);
+    reducedH = std::min(height, outH * 2);
+}
+
+void resizeArea(const unsigned char* pixels, int width, int height,
+                unsigned char* out, int outW, int outH) {
+    int reducedW, reducedH;
+    BoxReducer::reducedSize(width, height, outW, outH, reducedW, reducedH);
+    BoxReducer reducer(width, height, reducedW, reducedH);
+    reducer.addRows(pixels, static_cast<size_t>(width) * 4, height, 4);
+    reducer.finish(out, outW, outH);
+}
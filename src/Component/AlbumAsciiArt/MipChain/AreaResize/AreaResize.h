@@ -0,0 +1,119 @@
+/**
+ * @file AreaResize.h
+ * @author Amin Karic
+ * @brief Gamma-correct area downscaling for large reduction ratios.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Cover art arrives at 500 to 3000 pixels a side and is shown a few dozen
+ * cells wide, so every resize of a new image is a reduction by 4 to 100
+ * times. A general resampler evaluates a filter kernel with weights for each
+ * output pixel; at these ratios averaging the covered pixels is just as good
+ * and needs only additions.
+ *
+ * The image is first reduced by an integer box to at least twice the output
+ * size, each box covering a whole number of source pixels, then an area
+ * filter with fractional edge weights takes it to the exact size. Pixels are
+ * averaged in linear light with alpha premultiplied, like
+ * stbir_resize_uint8_srgb, and each pixel is accumulated as one vector of
+ * four floats with SSE2 or NEON.
+ *
+ * The boxes are summed a row at a time by a BoxReducer, which a decoder can
+ * feed strips of rows as they are decoded, so an image never has to be held
+ * whole at its full size.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class BoxReducer
+ *
+ * @brief Reduces an image by integer boxes from rows fed in order, then
+ * area-filters the result to its final size.
+ *
+ * @details Box i of a row covers source pixels [i * width / reducedW,
+ * (i + 1) * width / reducedW), and likewise for the rows of a band, so boxes
+ * differ by at most one pixel and no source pixel is dropped. Memory is one
+ * row of sums and the reduced image, whatever the source size.
+ */
+class BoxReducer {
+   private:
+    int width;            // Source width
+    int height;           // Source height
+    int reducedW;         // Width after the boxes
+    int reducedH;         // Height after the boxes
+    std::vector<int> edges;      // First source column of each box, and end
+    std::vector<float> sums;     // Sums of the current band's boxes
+    std::vector<float> reduced;  // Linear premultiplied RGBA per box
+    int nextRow = 0;      // Source row expected next
+    int band = 0;         // Reduced row being summed
+    int bandBottom = 0;   // Source row ending the current band
+
+    /**
+     * @brief Returns the first source row of a band.
+     */
+    int bandEdge(int index) const noexcept;
+
+   public:
+    /**
+     * @brief Prepares to reduce an image.
+     *
+     * @param width source width, at least reducedW
+     * @param height source height, at least reducedH
+     * @param reducedW width after the boxes, at least 1
+     * @param reducedH height after the boxes, at least 1
+     */
+    BoxReducer(int width, int height, int reducedW, int reducedH);
+
+    /**
+     * @brief Returns the size to reduce to before filtering to outW x outH.
+     *
+     * @details Whole ratios reduce straight to the output, others to at most
+     * twice its size.
+     */
+    static void reducedSize(int width, int height, int outW, int outH,
+                            int& reducedW, int& reducedH) noexcept;
+
+    /**
+     * @brief Adds the next rows of the image.
+     *
+     * @param rows first row, sRGB with straight alpha
+     * @param stride bytes from one row to the next
+     * @param count number of rows, rows past the image are ignored
+     * @param channels 4 for RGBA, 3 for opaque RGB
+     */
+    void addRows(const unsigned char* rows, size_t stride, int count,
+                 int channels);
+
+    /**
+     * @brief Returns true once every row of the image was added.
+     */
+    bool complete() const noexcept { return band == reducedH; }
+
+    /**
+     * @brief Area-filters the reduced image to its final size.
+     *
+     * @param out receives outW * outH RGBA pixels
+     * @param outW output width, at most the reduced width
+     * @param outH output height, at most the reduced height
+     */
+    void finish(unsigned char* out, int outW, int outH) const;
+};
+
+/**
+ * @brief Downscales RGBA pixels by averaging the area each output pixel
+ * covers.
+ *
+ * @param pixels source RGBA pixels, 4 bytes each, sRGB with straight alpha
+ * @param width source width, at least outW
+ * @param height source height, at least outH
+ * @param out receives outW * outH RGBA pixels
+ * @param outW output width, at least 1
+ * @param outH output height, at least 1
+ */
+void resizeArea(const unsigned char* pixels, int width, int height,
+                unsigned char* out, int outW, int outH);
@@ -0,0 +1,277 @@
+/**
+ * @file DominantColors.cpp
+ * @author Amin Karic
+ * @brief DominantColors implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for DominantColors class.
+ */
+
+#include "DominantColors.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+constexpr int ROUNDS = 4;          // k-means rounds after the median cut
+constexpr float MIN_CHROMA = 32;   // Below this a color counts as gray
+constexpr float MIN_LUMA = 128;    // Accents are lightened up to this
+// Weighted squared distance below which two colors count as one, about 24
+// per channel
+constexpr float MIN_SEPARATION = 9 * 24 * 24;
+
+/**
+ * @brief Pixels sharing their top 5 bits per channel.
+ */
+struct Group {
+    std::array<float, 3> mean;  // Mean color of the pixels
+    uint32_t count;             // Number of pixels
+};
+
+/**
+ * @brief A color being refined, with the pixels nearest it.
+ */
+struct Cluster {
+    std::array<float, 3> color;
+    uint32_t count;
+};
+
+// Squared distance weighted roughly by how sensitive the eye is to each
+// channel
+float distance(const std::array<float, 3>& a,
+               const std::array<float, 3>& b) noexcept {
+    float dr = a[0] - b[0];
+    float dg = a[1] - b[1];
+    float db = a[2] - b[2];
+    return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+std::vector<Group> groupPixels(const unsigned char* rgba, size_t pixels) {
+    std::vector<uint32_t> keys;
+    keys.reserve(pixels);
+    for (size_t i = 0; i < pixels; ++i) {
+        const unsigned char* p = rgba + i * 4;
+        if (p[3] < 128) {
+            continue;
+        }
+        uint32_t key = static_cast<uint32_t>((p[0] >> 3) << 10 |
+                                             (p[1] >> 3) << 5 | (p[2] >> 3));
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Groups are placed at the middle of their bucket, close enough at 5
+    // bits per channel
+    auto middle = [](uint32_t bits) {
+        return static_cast<float>((bits & 0x1F) << 3 | 4);
+    };
+    std::vector<Group> groups;
+    for (size_t i = 0; i < keys.size();) {
+        size_t end = i;
+        while (end < keys.size() && keys[end] == keys[i]) {
+            ++end;
+        }
+        uint32_t key = keys[i];
+        groups.push_back(
+            Group{{middle(key >> 10), middle(key >> 5), middle(key)},
+                  static_cast<uint32_t>(end - i)});
+        i = end;
+    }
+    return groups;
+}
+
+// Splits the groups into at most count boxes of similar colors, each box a
+// range of the reordered groups
+std::vector<Cluster> medianCut(std::vector<Group>& groups, size_t count) {
+    struct Box {
+        size_t begin;
+        size_t end;
+        uint32_t count;
+        int axis;     // Channel with the widest range
+        float range;  // Range of that channel
+    };
+    auto makeBox = [&groups](size_t begin, size_t end) {
+        Box box{begin, end, 0, 0, 0.0f};
+        std::array<float, 3> low{255, 255, 255};
+        std::array<float, 3> high{0, 0, 0};
+        for (size_t i = begin; i < end; ++i) {
+            box.count += groups[i].count;
+            for (int c = 0; c < 3; ++c) {
+                low[c] = std::min(low[c], groups[i].mean[c]);
+                high[c] = std::max(high[c], groups[i].mean[c]);
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            if (high[c] - low[c] > box.range) {
+                box.range = high[c] - low[c];
+                box.axis = c;
+            }
+        }
+        return box;
+    };
+
+    std::vector<Box> boxes{makeBox(0, groups.size())};
+    while (boxes.size() < count) {
+        // Split the box whose colors are most spread over the most pixels
+        size_t widest = boxes.size();
+        float widestScore = 0;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            float score = boxes[i].range * boxes[i].count;
+            if (boxes[i].end - boxes[i].begin > 1 && score > widestScore) {
+                widest = i;
+                widestScore = score;
+            }
+        }
+        if (widest == boxes.size()) {
+            break;
+        }
+
+        Box box = boxes[widest];
+        int axis = box.axis;
+        std::sort(groups.begin() + box.begin, groups.begin() + box.end,
+                  [axis](const Group& a, const Group& b) {
+                      return a.mean[axis] < b.mean[axis];
+                  });
+        // Split at the median pixel, leaving a group on each side
+        size_t split = box.begin + 1;
+        uint32_t below = groups[box.begin].count;
+        while (split + 1 < box.end && below * 2 < box.count) {
+            below += groups[split].count;
+            ++split;
+        }
+        boxes[widest] = makeBox(box.begin, split);
+        boxes.push_back(makeBox(split, box.end));
+    }
+
+    std::vector<Cluster> clusters;
+    for (const Box& box : boxes) {
+        Cluster cluster{{0, 0, 0}, box.count};
+        for (size_t i = box.begin; i < box.end; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                cluster.color[c] += groups[i].mean[c] * groups[i].count;
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            cluster.color[c] /= box.count;
+        }
+        clusters.push_back(cluster);
+    }
+    return clusters;
+}
+
+// Moves each cluster to the mean of the groups nearest it
+void refine(const std::vector<Group>& groups, std::vector<Cluster>& clusters) {
+    std::vector<std::array<float, 3>> sums(clusters.size());
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::fill(sums.begin(), sums.end(), std::array<float, 3>{0, 0, 0});
+        for (Cluster& cluster : clusters) {
+            cluster.count = 0;
+        }
+        for (const Group& group : groups) {
+            size_t nearest = 0;
+            float nearestDistance = distance(group.mean, clusters[0].color);
+            for (size_t k = 1; k < clusters.size(); ++k) {
+                float d = distance(group.mean, clusters[k].color);
+                if (d < nearestDistance) {
+                    nearest = k;
+                    nearestDistance = d;
+                }
+            }
+            clusters[nearest].count += group.count;
+            for (int c = 0; c < 3; ++c) {
+                sums[nearest][c] += group.mean[c] * group.count;
+            }
+        }
+        for (size_t k = 0; k < clusters.size(); ++k) {
+            // A cluster left without groups keeps its color and is dropped
+            // once the rounds are over
+            if (clusters[k].count == 0) {
+                continue;
+            }
+            for (int c = 0; c < 3; ++c) {
+                clusters[k].color[c] = sums[k][c] / clusters[k].count;
+            }
+        }
+    }
+}
+
+uint32_t pack(const std::array<float, 3>& color) noexcept {
+    auto channel = [](float v) {
+        return static_cast<uint32_t>(std::clamp(v + 0.5f, 0.0f, 255.0f));
+    };
+    return channel(color[0]) << 24 | channel(color[1]) << 16 |
+           channel(color[2]) << 8 | 0xFF;
+}
+
+}  // namespace
+
+std::vector<uint32_t> DominantColors::extract(const unsigned char* rgba,
+                                              size_t pixels, size_t count) {
+    std::vector<Group> groups = groupPixels(rgba, pixels);
+    if (groups.empty() || count == 0) {
+        return {};
+    }
+
+    std::vector<Cluster> clusters = medianCut(groups, count);
+    refine(groups, clusters);
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) {
+                         return a.count > b.count;
+                     });
+
+    // Noise in a large area can split it in two, keep only the more common
+    // of colors that look alike
+    std::vector<uint32_t> colors;
+    std::vector<std::array<float, 3>> kept;
+    for (const Cluster& cluster : clusters) {
+        if (cluster.count == 0) {
+            continue;
+        }
+        auto alike = [&cluster](const std::array<float, 3>& color) {
+            return distance(color, cluster.color) < MIN_SEPARATION;
+        };
+        bool distinct = std::none_of(kept.begin(), kept.end(), alike);
+        if (distinct) {
+            kept.push_back(cluster.color);
+            colors.push_back(pack(cluster.color));
+        }
+    }
+    return colors;
+}
+
+uint32_t DominantColors::accent(const std::vector<uint32_t>& colors,
+                                uint32_t fallback) {
+    if (colors.empty()) {
+        return fallback;
+    }
+
+    // The most vivid color, each rank down counting for less, or the most
+    // common one if the cover is nearly gray
+    std::array<float, 3> best{};
+    float bestScore = -1;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        std::array<float, 3> color{static_cast<float>(colors[i] >> 24),
+                                   static_cast<float>((colors[i] >> 16) & 0xFF),
+                                   static_cast<float>((colors[i] >> 8) & 0xFF)};
+        float chroma = *std::max_element(color.begin(), color.end()) -
+                       *std::min_element(color.begin(), color.end());
+        float score = chroma < MIN_CHROMA ? 0 : chroma / (1.0f + 0.25f * i);
+        if (score > bestScore) {
+            best = color;
+            bestScore = score;
+        }
+    }
+
+    // Blend towards white until the accent stands out on a dark terminal
+    float luma = 0.299f * best[0] + 0.587f * best[1] + 0.114f * best[2];
+    if (luma < MIN_LUMA) {
+        float t = (MIN_LUMA - luma) / (255 - luma);
+        for (float& c : best) {
+            c += (255 - c) * t;
+        }
+    }
+    return pack(best);
+}
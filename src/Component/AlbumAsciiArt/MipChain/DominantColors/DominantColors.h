@@ -0,0 +1,60 @@
+/**
+ * @file DominantColors.h
+ * @author Amin Karic
+ * @brief DominantColors class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * The accent colors of the interface follow the album art, which needs the
+ * few colors that cover most of the cover. They are found on a small level
+ * of the MipChain, about a thousand pixels, when the chain is built: pixels
+ * are grouped by their top 5 bits per channel, the groups are split by
+ * median cut into boxes of similar colors, and a few rounds of k-means move
+ * each box's color to the mean of the groups nearest it. Working on groups
+ * rather than pixels keeps the whole step in the tens of microseconds.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class DominantColors
+ *
+ * @brief Extracts the dominant colors of an image.
+ */
+class DominantColors {
+   public:
+    static constexpr size_t DEFAULT_COUNT = 5;  // Colors kept per image
+    static constexpr int SAMPLE_SIZE = 32;      // Smallest level sampled
+
+    /**
+     * @brief Returns the dominant colors of some pixels, most common first.
+     *
+     * @param rgba pixels, 4 bytes each, mostly transparent ones are ignored
+     * @param pixels number of pixels
+     * @param count maximum number of colors
+     * @return std::vector<uint32_t> opaque 0xRRGGBBAA colors, fewer than
+     * count if the pixels have fewer distinct colors, empty if all are
+     * transparent
+     */
+    static std::vector<uint32_t> extract(const unsigned char* rgba,
+                                         size_t pixels,
+                                         size_t count = DEFAULT_COUNT);
+
+    /**
+     * @brief Picks a color to draw accents with on a dark background.
+     *
+     * @details Prefers vivid colors over common ones only when they are
+     * close in rank, and lightens the pick until it is readable.
+     *
+     * @param colors colors from extract()
+     * @param fallback color returned when there are none
+     * @return uint32_t opaque accent color
+     */
+    static uint32_t accent(const std::vector<uint32_t>& colors,
+                           uint32_t fallback);
+};
@@ -0,0 +1,99 @@
+/**
+ * @file MipChain.cpp
+ * @author Amin Karic
+ * @brief MipChain implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for MipChain class.
+ */
+
+#include "MipChain.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../../stb/stb_image_resize2.h"
+#include "AreaResize/AreaResize.h"
+#include "DominantColors/DominantColors.h"
+
+namespace {
+
+void resize(const unsigned char* pixels, int width, int height, int outW,
+            int outH, ResizeFilter filter, std::vector<unsigned char>& rgba) {
+    rgba.resize(static_cast<size_t>(outW) * outH * 4);
+    if (outW == width && outH == height) {
+        std::copy(pixels, pixels + rgba.size(), rgba.begin());
+        return;
+    }
+    // Whole ratios take only the box step, and from a third of the size down
+    // the area filter averages enough pixels per output pixel to beat the
+    // kernel; in between it is slower and only blurs
+    bool whole = width % outW == 0 && height % outH == 0;
+    bool large = outW * 3 <= width && outH * 3 <= height;
+    if (filter == ResizeFilter::Area && outW <= width && outH <= height &&
+        (whole || large)) {
+        resizeArea(pixels, width, height, rgba.data(), outW, outH);
+        return;
+    }
+    stbir_resize_uint8_srgb(pixels, width, height, 0, rgba.data(), outW, outH,
+                            0, STBIR_RGBA);
+}
+
+}  // namespace
+
+MipChain::MipChain(Level&& base, ResizeFilter filter) : filter(filter) {
+    levels.push_back(std::move(base));
+    while (levels.back().width > MIN_SIZE && levels.back().height > MIN_SIZE) {
+        const Level& above = levels.back();
+        Level level;
+        level.width = std::max(above.width / 2, 1);
+        level.height = std::max(above.height / 2, 1);
+        resize(above.rgba.data(), above.width, above.height, level.width,
+               level.height, filter, level.rgba);
+        levels.push_back(std::move(level));
+    }
+
+    const Level& sample =
+        nearest(DominantColors::SAMPLE_SIZE, DominantColors::SAMPLE_SIZE);
+    dominant = DominantColors::extract(
+        sample.rgba.data(), static_cast<size_t>(sample.width) * sample.height);
+}
+
+std::shared_ptr<const MipChain> MipChain::fromImage(
+    const unsigned char* pixels, int width, int height,
+    ResizeFilter filter) {
+    Level base;
+    baseSize(width, height, base.width, base.height);
+    resize(pixels, width, height, base.width, base.height, filter, base.rgba);
+    return std::make_shared<const MipChain>(std::move(base), filter);
+}
+
+void MipChain::baseSize(int width, int height, int& baseW,
+                        int& baseH) noexcept {
+    int longer = std::max(width, height);
+    if (longer <= BASE_SIZE) {
+        baseW = width;
+        baseH = height;
+        return;
+    }
+    baseW = std::max(1, static_cast<int>(static_cast<long long>(width) *
+                                         BASE_SIZE / longer));
+    baseH = std::max(1, static_cast<int>(static_cast<long long>(height) *
+                                         BASE_SIZE / longer));
+}
+
+const MipChain::Level& MipChain::nearest(int w, int h) const noexcept {
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+        if (level->width >= w && level->height >= h) {
+            return *level;
+        }
+    }
+    return levels.front();
+}
+
+void MipChain::resample(int w, int h, std::vector<unsigned char>& rgba) const {
+    const Level& level = nearest(w, h);
+    resize(level.rgba.data(), level.width, level.height, w, h, filter, rgba);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file MipChain.h
+ * @author Amin Karic
+ * @brief MipChain class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Album art is shown at whatever size the layout gives it, which changes when
+ * the terminal is resized or the layout switches between compact and full.
+ * Rather than decoding the original image again, each image keeps a short
+ * chain of downscaled copies: a base level at most BASE_SIZE pixels on its
+ * longer side and halvings of it down to MIN_SIZE. A new size is resampled
+ * from the smallest level that is still at least as large, so it costs a
+ * resize of a few thousand pixels.
+ *
+ * Each chain resizes with the filter it was created with. Area averages the
+ * covered pixels, which at the large ratios of cover art is as good as a
+ * filter kernel and several times faster; Mitchell goes through
+ * stb_image_resize for the sharper result of its default filter.
+ *
+ * The chain also keeps the image's dominant colors, for theming the
+ * interface after the art. They are found on one of the small levels, see
+ * DominantColors.h, so they come with every decoded or cached thumbnail for
+ * a few microseconds.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Filter used to resize the levels of a MipChain.
+ *
+ * Area: Gamma-correct average of the covered pixels, see AreaResize.h.
+ * Resizes by less than 3x fall back to Mitchell, unless the ratio is whole
+ * as for the halvings below the base level.
+ * Mitchell: stbir_resize_uint8_srgb with its default filters
+ */
+enum class ResizeFilter { Area, Mitchell };
+
+/**
+ * @class MipChain
+ *
+ * @brief Downscaled copies of an image, largest first.
+ */
+class MipChain {
+   public:
+    static constexpr int BASE_SIZE = 256;  // Longer side of the base level
+    static constexpr int MIN_SIZE = 8;     // Smallest level kept
+
+    /**
+     * @brief One level of the chain.
+     */
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> rgba;  // width * height RGBA pixels
+    };
+
+   private:
+    std::vector<Level> levels;  // Base level first, each half the previous
+    ResizeFilter filter;        // Filter building and resampling the levels
+    std::vector<uint32_t> dominant;  // Dominant colors, most common first
+
+   public:
+    /**
+     * @brief Builds the chain below a base level.
+     *
+     * @param base base level, as sized by baseSize()
+     * @param filter filter for the levels below and for resample()
+     */
+    explicit MipChain(Level&& base,
+                      ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Builds the chain from a decoded image.
+     *
+     * @param pixels RGBA pixels, 4 bytes each
+     * @param width image width in pixels
+     * @param height image height in pixels
+     * @param filter filter for every level and for resample()
+     */
+    static std::shared_ptr<const MipChain> fromImage(
+        const unsigned char* pixels, int width, int height,
+        ResizeFilter filter = ResizeFilter::Area);
+
+    /**
+     * @brief Returns the size of the base level for an image.
+     *
+     * @details The image is scaled down to fit BASE_SIZE, keeping its aspect
+     * ratio, and never scaled up.
+     */
+    static void baseSize(int width, int height, int& baseW,
+                         int& baseH) noexcept;
+
+    /**
+     * @brief Returns the filter the chain resizes with.
+     */
+    ResizeFilter getFilter() const noexcept { return filter; }
+
+    /**
+     * @brief Returns the dominant colors of the image, most common first.
+     *
+     * @return const std::vector<uint32_t>& opaque colors, empty if the
+     * image is transparent
+     */
+    const std::vector<uint32_t>& dominantColors() const noexcept {
+        return dominant;
+    }
+
+    /**
+     * @brief Returns the base level.
+     */
+    const Level& base() const noexcept { return levels.front(); }
+
+    /**
+     * @brief Returns the number of levels.
+     */
+    size_t levelCount() const noexcept { return levels.size(); }
+
+    /**
+     * @brief Returns the smallest level at least w x h, or the base level if
+     * none is that large.
+     */
+    const Level& nearest(int w, int h) const noexcept;
+
+    /**
+     * @brief Resamples the image from the nearest level.
+     *
+     * @param w width in pixels
+     * @param h height in pixels
+     * @param rgba receives w * h RGBA pixels
+     */
+    void resample(int w, int h, std::vector<unsigned char>& rgba) const;
+};
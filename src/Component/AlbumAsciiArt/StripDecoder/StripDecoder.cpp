@@ -0,0 +1,168 @@
+/**
+ * @file StripDecoder.cpp
+ * @author Amin Karic
+ * @brief StripDecoder implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for StripDecoder class.
+ */
+
+#include "StripDecoder.h"
+
+#include <utility>
+#include <vector>
+
+#include "../MipChain/AreaResize/AreaResize.h"
+
+#if defined(MUSCLI_USE_LIBJPEG)
+#include <csetjmp>
+#include <cstdio>
+#include <iostream>
+
+#include <jpeglib.h>
+
+namespace {
+
+constexpr int STRIP_ROWS = 16;  // Rows decoded per call
+
+/**
+ * @brief libjpeg error handler that jumps back instead of exiting.
+ *
+ * @details libjpeg reports errors by calling error_exit, which must not
+ * return. Each step below sets a jump point in a frame holding no objects
+ * with destructors, so the longjmp skips nothing but libjpeg's own frames.
+ */
+struct ErrorManager {
+    jpeg_error_mgr base;  // Must come first, libjpeg sees only this
+    std::jmp_buf jump;    // Where errors return to
+    char message[JMSG_LENGTH_MAX];  // Last error
+};
+
+void errorExit(j_common_ptr cinfo) {
+    ErrorManager* err = reinterpret_cast<ErrorManager*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    std::longjmp(err->jump, 1);
+}
+
+// Corrupt data warnings are not worth a message, the image still decodes
+void ignoreMessage(j_common_ptr, int) {}
+
+/**
+ * @brief Reads the header and starts decoding at the smallest DCT scale at
+ * least as large as the base level.
+ *
+ * @param baseW receives the width of the base level
+ * @param baseH receives the height of the base level
+ */
+bool start(jpeg_decompress_struct& cinfo, ErrorManager& err,
+           const unsigned char* data, size_t size, int& baseW, int& baseH) {
+    if (setjmp(err.jump)) {
+        return false;
+    }
+    jpeg_mem_src(&cinfo, data, static_cast<unsigned long>(size));
+    jpeg_read_header(&cinfo, TRUE);
+    MipChain::baseSize(static_cast<int>(cinfo.image_width),
+                       static_cast<int>(cinfo.image_height), baseW, baseH);
+
+    cinfo.out_color_space = JCS_RGB;
+    cinfo.scale_num = 1;
+    for (unsigned int denom : {8u, 4u, 2u, 1u}) {
+        // Scaled sizes round up
+        unsigned int w = (cinfo.image_width + denom - 1) / denom;
+        unsigned int h = (cinfo.image_height + denom - 1) / denom;
+        if (denom == 1 || (w >= static_cast<unsigned int>(baseW) &&
+                           h >= static_cast<unsigned int>(baseH))) {
+            cinfo.scale_denom = denom;
+            break;
+        }
+    }
+    jpeg_start_decompress(&cinfo);
+    return true;
+}
+
+/**
+ * @brief Decodes the next strip of rows.
+ */
+bool readStrip(jpeg_decompress_struct& cinfo, ErrorManager& err,
+               JSAMPARRAY rows, int& count) {
+    if (setjmp(err.jump)) {
+        return false;
+    }
+    count = static_cast<int>(jpeg_read_scanlines(&cinfo, rows, STRIP_ROWS));
+    return true;
+}
+
+}  // namespace
+
+bool StripDecoder::available() noexcept { return true; }
+
+std::shared_ptr<const MipChain> StripDecoder::decode(
+    const unsigned char* data, size_t size, ResizeFilter filter) {
+    if (!isJPEG(data, size)) {
+        return nullptr;
+    }
+
+    jpeg_decompress_struct cinfo;
+    ErrorManager err;
+    cinfo.err = jpeg_std_error(&err.base);
+    err.base.error_exit = errorExit;
+    err.base.emit_message = ignoreMessage;
+    jpeg_create_decompress(&cinfo);
+
+    MipChain::Level base;
+    if (!start(cinfo, err, data, size, base.width, base.height)) {
+        std::cerr << "Error: Failed to decode JPEG: " << err.message
+                  << std::endl;
+        jpeg_destroy_decompress(&cinfo);
+        return nullptr;
+    }
+
+    int width = static_cast<int>(cinfo.output_width);
+    int height = static_cast<int>(cinfo.output_height);
+    int reducedW, reducedH;
+    BoxReducer::reducedSize(width, height, base.width, base.height, reducedW,
+                            reducedH);
+    BoxReducer reducer(width, height, reducedW, reducedH);
+
+    size_t stride = static_cast<size_t>(width) * 3;
+    std::vector<unsigned char> strip(stride * STRIP_ROWS);
+    JSAMPROW rows[STRIP_ROWS];
+    for (int i = 0; i < STRIP_ROWS; ++i) {
+        rows[i] = strip.data() + stride * i;
+    }
+
+    while (cinfo.output_scanline < cinfo.output_height) {
+        int count = 0;
+        if (!readStrip(cinfo, err, rows, count)) {
+            std::cerr << "Error: Failed to decode JPEG: " << err.message
+                      << std::endl;
+            jpeg_destroy_decompress(&cinfo);
+            return nullptr;
+        }
+        reducer.addRows(strip.data(), stride, count, 3);
+    }
+    // Trailing data after the last row is of no interest
+    jpeg_destroy_decompress(&cinfo);
+
+    base.rgba.resize(static_cast<size_t>(base.width) * base.height * 4);
+    reducer.finish(base.rgba.data(), base.width, base.height);
+    return std::make_shared<const MipChain>(std::move(base), filter);
+}
+
+#else
+
+bool StripDecoder::available() noexcept { return false; }
+
+std::shared_ptr<const MipChain> StripDecoder::decode(const unsigned char*,
+                                                     size_t, ResizeFilter) {
+    return nullptr;
+}
+
+#endif
+
+bool StripDecoder::isJPEG(const unsigned char* data, size_t size) noexcept {
+    return data != nullptr && size >= 3 && data[0] == 0xFF &&
+           data[1] == 0xD8 && data[2] == 0xFF;
+}
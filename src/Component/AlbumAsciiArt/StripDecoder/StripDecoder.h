@@ -0,0 +1,65 @@
+/**
+ * @file StripDecoder.h
+ * @author Amin Karic
+ * @brief StripDecoder class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Embedded covers can be 3000x3000 or larger, and stb_image decodes the
+ * whole image to RGBA, 36 MB and up, before it is reduced to a base level of
+ * at most MipChain::BASE_SIZE pixels. JPEG, the format nearly all covers
+ * use, can be decoded a few rows at a time and at 1/2, 1/4 or 1/8 of its size
+ * by scaling the DCT, which also skips most of the decoding work.
+ *
+ * With libjpeg, JPEGs are decoded at the smallest DCT scale still as large
+ * as the base level, in strips of rows fed to a BoxReducer, so memory stays
+ * bounded by the scaled width whatever the image size. Progressive JPEGs
+ * still make libjpeg buffer the coefficients of the whole image.
+ *
+ * Define MUSCLI_USE_LIBJPEG and link with -ljpeg to enable it. Without it, or
+ * for other formats, decode() returns null and callers decode with
+ * stb_image.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "../MipChain/MipChain.h"
+
+/**
+ * @class StripDecoder
+ *
+ * @brief Decodes JPEGs in strips straight to a MipChain.
+ */
+class StripDecoder {
+   public:
+    /**
+     * @brief Returns true if built with libjpeg.
+     */
+    static bool available() noexcept;
+
+    /**
+     * @brief Returns true if the bytes start like a JPEG.
+     */
+    static bool isJPEG(const unsigned char* data, size_t size) noexcept;
+
+    /**
+     * @brief Decodes a JPEG to a chain whose base level is sized by
+     * MipChain::baseSize().
+     *
+     * @details Safe to call from any thread. The base level is always
+     * reduced with the area filter, the filter given is kept by the chain.
+     *
+     * @param data encoded image bytes
+     * @param size number of bytes
+     * @param filter filter for the levels below the base and for resampling
+     * @return std::shared_ptr<const MipChain> decoded image, null if not a
+     * JPEG, not built with libjpeg or the JPEG could not be decoded
+     */
+    static std::shared_ptr<const MipChain> decode(const unsigned char* data,
+                                                  size_t size,
+                                                  ResizeFilter filter);
+};
@@ -0,0 +1,372 @@
+/**
+ * @file ThumbnailCache.cpp
+ * @author Amin Karic
+ * @brief ThumbnailCache implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for ThumbnailCache class.
+ */
+
+#include "ThumbnailCache.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'U', 'S', 'C', 'L', 'I', 'T', 'C'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t BLOCK = 256;  // Data area allocation unit
+
+size_t roundUp(size_t bytes, size_t unit) noexcept {
+    return (bytes + unit - 1) / unit * unit;
+}
+
+/**
+ * @brief Holds an exclusive flock() on a file for its lifetime.
+ */
+class FileLock {
+   private:
+    int fd;
+    bool locked;
+
+   public:
+    explicit FileLock(int fd) : fd(fd), locked(::flock(fd, LOCK_EX) == 0) {}
+    ~FileLock() {
+        if (locked) {
+            ::flock(fd, LOCK_UN);
+        }
+    }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    bool isLocked() const noexcept { return locked; }
+};
+
+}  // namespace
+
+/**
+ * @brief Start of the cache file.
+ */
+struct ThumbnailCache::Header {
+    char magic[8];        // MAGIC
+    uint32_t version;     // VERSION
+    uint32_t entryCount;  // Index slots
+    uint64_t capacity;    // Data area bytes
+    uint64_t clock;       // Stamp of the last access, for LRU
+    uint32_t used;        // Occupied index slots
+    uint32_t reserved;
+};
+
+/**
+ * @brief An index slot.
+ */
+struct ThumbnailCache::Entry {
+    uint64_t hash;        // Hash of the encoded image
+    uint64_t sourceSize;  // Size of the encoded image
+    uint64_t lastUsed;    // Header clock at the last access
+    uint64_t offset;      // Start of the pixels in the data area
+    uint32_t bytes;       // Size of the pixels, 0 if the slot is free
+    uint16_t width;       // Thumbnail size in pixels
+    uint16_t height;
+};
+
+namespace {
+
+uint32_t homeSlot(uint64_t hash, uint64_t sourceSize, uint32_t w, uint32_t h,
+                  uint32_t entryCount) noexcept {
+    uint64_t key = hash ^ (sourceSize * 0x9E3779B97F4A7C15ULL) ^
+                   (static_cast<uint64_t>(w) << 32) ^
+                   (static_cast<uint64_t>(h) << 48);
+    key ^= key >> 29;
+    return static_cast<uint32_t>(key % entryCount);
+}
+
+}  // namespace
+
+ThumbnailCache::ThumbnailCache(const std::string& path, size_t capacity,
+                               uint32_t entries)
+    : entryCount(std::max<uint32_t>(entries, 1)),
+      capacity(capacity / BLOCK * BLOCK) {
+    if (path.empty()) {
+        return;
+    }
+    std::error_code ignored;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ignored);
+    }
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+
+    mapSize = dataOffset(entryCount) + this->capacity;
+    FileLock lock(fd);
+    struct stat st;
+    bool sized = lock.isLocked() && ::fstat(fd, &st) == 0 &&
+                 (static_cast<size_t>(st.st_size) == mapSize ||
+                  ::ftruncate(fd, static_cast<off_t>(mapSize)) == 0);
+    void* mapped = sized ? ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED, fd, 0)
+                         : MAP_FAILED;
+    if (mapped == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    map = static_cast<unsigned char*>(mapped);
+    if (!validate()) {
+        ::munmap(map, mapSize);
+        map = nullptr;
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    if (map != nullptr) {
+        ::munmap(map, mapSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+size_t ThumbnailCache::dataOffset(uint32_t entryCount) noexcept {
+    return roundUp(sizeof(Header) + entryCount * sizeof(Entry), BLOCK);
+}
+
+ThumbnailCache::Header& ThumbnailCache::header() const noexcept {
+    return *reinterpret_cast<Header*>(map);
+}
+
+ThumbnailCache::Entry* ThumbnailCache::entries() const noexcept {
+    return reinterpret_cast<Entry*>(map + sizeof(Header));
+}
+
+unsigned char* ThumbnailCache::data() const noexcept {
+    return map + dataOffset(entryCount);
+}
+
+bool ThumbnailCache::validate() {
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != mapSize) {
+        return false;
+    }
+    Header& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+        h.version == VERSION && h.entryCount == entryCount &&
+        h.capacity == capacity) {
+        uint32_t used = 0;
+        const Entry* e = entries();
+        for (uint32_t i = 0; i < entryCount; ++i) {
+            used += e[i].bytes != 0;
+        }
+        h.used = used;
+        return true;
+    }
+    // Written by another version or with another size, start over
+    std::memset(map, 0, dataOffset(entryCount));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.entryCount = entryCount;
+    h.capacity = capacity;
+    return true;
+}
+
+uint32_t ThumbnailCache::find(uint64_t hash, uint64_t sourceSize, uint32_t w,
+                              uint32_t h) const noexcept {
+    Entry* e = entries();
+    uint32_t slot = homeSlot(hash, sourceSize, w, h, entryCount);
+    for (uint32_t probes = 0; probes < entryCount; ++probes) {
+        const Entry& entry = e[slot];
+        if (entry.bytes == 0) {
+            break;
+        }
+        if (entry.hash == hash && entry.sourceSize == sourceSize &&
+            entry.width == w && entry.height == h) {
+            return slot;
+        }
+        slot = slot + 1 == entryCount ? 0 : slot + 1;
+    }
+    return entryCount;
+}
+
+void ThumbnailCache::remove(uint32_t slot) noexcept {
+    // Backward shift deletion keeps every probe sequence unbroken without
+    // tombstones
+    Entry* e = entries();
+    uint32_t hole = slot;
+    uint32_t next = slot;
+    while (true) {
+        next = next + 1 == entryCount ? 0 : next + 1;
+        if (e[next].bytes == 0 || next == slot) {
+            break;
+        }
+        uint32_t home = homeSlot(e[next].hash, e[next].sourceSize,
+                                 e[next].width, e[next].height, entryCount);
+        // The entry may move into the hole if the hole lies cyclically
+        // between its home slot and where it is now
+        bool movable = hole <= next ? (home <= hole || home > next)
+                                    : (home <= hole && home > next);
+        if (movable) {
+            e[hole] = e[next];
+            hole = next;
+        }
+    }
+    e[hole] = Entry{};
+    --header().used;
+}
+
+bool ThumbnailCache::evictOldest() noexcept {
+    Entry* e = entries();
+    uint32_t oldest = entryCount;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        if (e[i].bytes != 0 &&
+            (oldest == entryCount || e[i].lastUsed < e[oldest].lastUsed)) {
+            oldest = i;
+        }
+    }
+    if (oldest == entryCount) {
+        return false;
+    }
+    remove(oldest);
+    return true;
+}
+
+bool ThumbnailCache::allocate(size_t bytes, uint64_t& offset) const {
+    std::vector<std::pair<uint64_t, uint64_t>> spans;  // Start, end
+    spans.reserve(header().used);
+    const Entry* e = entries();
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        if (e[i].bytes != 0) {
+            spans.emplace_back(e[i].offset,
+                               e[i].offset + roundUp(e[i].bytes, BLOCK));
+        }
+    }
+    std::sort(spans.begin(), spans.end());
+
+    // First fit
+    uint64_t start = 0;
+    for (const auto& span : spans) {
+        if (span.first >= start + bytes) {
+            break;
+        }
+        start = std::max(start, span.second);
+    }
+    if (start + bytes > capacity) {
+        return false;
+    }
+    offset = start;
+    return true;
+}
+
+bool ThumbnailCache::lookup(uint64_t hash, uint64_t sourceSize, uint32_t w,
+                            uint32_t h, std::vector<unsigned char>& rgba) {
+    if (!isOpen()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(mtx);
+    FileLock lock(fd);
+    if (!lock.isLocked() || !validate()) {
+        return false;
+    }
+
+    uint32_t slot = find(hash, sourceSize, w, h);
+    if (slot == entryCount) {
+        return false;
+    }
+    Entry& entry = entries()[slot];
+    if (entry.bytes != static_cast<uint64_t>(w) * h * 4 ||
+        entry.offset + entry.bytes > capacity) {
+        remove(slot);  // Damaged entry
+        return false;
+    }
+    rgba.assign(data() + entry.offset, data() + entry.offset + entry.bytes);
+    entry.lastUsed = ++header().clock;
+    return true;
+}
+
+void ThumbnailCache::insert(uint64_t hash, uint64_t sourceSize, uint32_t w,
+                            uint32_t h, const unsigned char* rgba) {
+    size_t bytes = static_cast<size_t>(w) * h * 4;
+    if (!isOpen() || bytes == 0 || bytes > capacity || w > UINT16_MAX ||
+        h > UINT16_MAX) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(mtx);
+    FileLock lock(fd);
+    if (!lock.isLocked() || !validate()) {
+        return;
+    }
+
+    // Another player may have stored it meanwhile
+    uint32_t slot = find(hash, sourceSize, w, h);
+    if (slot != entryCount) {
+        entries()[slot].lastUsed = ++header().clock;
+        return;
+    }
+
+    // Keep the index at most three quarters full so probes stay short
+    while (header().used >= entryCount - entryCount / 4) {
+        if (!evictOldest()) {
+            break;
+        }
+    }
+    uint64_t offset;
+    while (!allocate(bytes, offset)) {
+        if (!evictOldest()) {
+            return;
+        }
+    }
+    std::memcpy(data() + offset, rgba, bytes);
+
+    Entry* e = entries();
+    slot = homeSlot(hash, sourceSize, w, h, entryCount);
+    while (e[slot].bytes != 0) {
+        slot = slot + 1 == entryCount ? 0 : slot + 1;
+    }
+    e[slot].hash = hash;
+    e[slot].sourceSize = sourceSize;
+    e[slot].lastUsed = ++header().clock;
+    e[slot].offset = offset;
+    e[slot].width = static_cast<uint16_t>(w);
+    e[slot].height = static_cast<uint16_t>(h);
+    e[slot].bytes = static_cast<uint32_t>(bytes);
+    ++header().used;
+}
+
+uint64_t ThumbnailCache::hash(const unsigned char* data, size_t size,
+                              uint8_t variant) noexcept {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ data[i]) * 1099511628211ULL;
+    }
+    return (h ^ variant) * 1099511628211ULL;
+}
+
+std::string ThumbnailCache::defaultPath() {
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg != nullptr && xdg[0] != '\0') {
+        return std::string(xdg) + "/muscli/thumbnails.bin";
+    }
+    const char* home = std::getenv("HOME");
+    if (home != nullptr && home[0] != '\0') {
+        return std::string(home) + "/.cache/muscli/thumbnails.bin";
+    }
+    return std::string();
+}
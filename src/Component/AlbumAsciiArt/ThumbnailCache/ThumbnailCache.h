@@ -0,0 +1,175 @@
+/**
+ * @file ThumbnailCache.h
+ * @author Amin Karic
+ * @brief ThumbnailCache class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Album art is decoded at full resolution only to keep a small copy of it.
+ * The ThumbnailCache keeps those copies on disk, keyed by a hash of the
+ * encoded image and the thumbnail size, so loading art that was seen before
+ * is a hash lookup and a copy instead of a decode.
+ *
+ * Everything lives in a single memory-mapped file: a header, an index kept as
+ * an open addressing hash table and a data area. The file has a fixed size,
+ * so the cache is capped; when the index or the data area is full, the least
+ * recently used thumbnails are evicted. Every access takes an exclusive
+ * flock() on the file, so several players can share one cache.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class ThumbnailCache
+ *
+ * @brief Persistent cache of resized RGBA album art.
+ */
+class ThumbnailCache {
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 32 << 20;  // Data area bytes
+    static constexpr uint32_t DEFAULT_ENTRIES = 1024;     // Index slots
+
+   private:
+    struct Header;
+    struct Entry;
+
+    std::mutex mtx;             // Serializes threads, flock() only separates
+                                // processes
+    int fd = -1;                // Cache file, -1 if the cache is disabled
+    unsigned char* map = nullptr;  // Whole file, shared
+    size_t mapSize = 0;         // Bytes mapped
+    uint32_t entryCount;        // Index slots
+    size_t capacity;            // Data area bytes
+
+    Header& header() const noexcept;
+    Entry* entries() const noexcept;
+    unsigned char* data() const noexcept;
+
+    /**
+     * @brief Returns the offset of the data area in the file.
+     */
+    static size_t dataOffset(uint32_t entryCount) noexcept;
+
+    /**
+     * @brief Checks the file layout, resetting the cache if it does not match.
+     *
+     * The header's entry count is recounted from the index, since a player
+     * that crashed mid-write or a torn write to the shared file can leave
+     * it stale.
+     *
+     * @return false if the file no longer has the mapped size, as when a
+     * player with another capacity resized it
+     */
+    bool validate();
+
+    /**
+     * @brief Returns the index slot holding a key, or entryCount.
+     */
+    uint32_t find(uint64_t hash, uint64_t sourceSize, uint32_t w,
+                  uint32_t h) const noexcept;
+
+    /**
+     * @brief Removes an index slot, shifting back the entries probed past it.
+     */
+    void remove(uint32_t slot) noexcept;
+
+    /**
+     * @brief Removes the least recently used entry.
+     *
+     * @return false if the cache is empty
+     */
+    bool evictOldest() noexcept;
+
+    /**
+     * @brief Finds free space in the data area.
+     *
+     * @param bytes bytes needed
+     * @param offset receives the offset into the data area
+     * @return false if no gap is large enough
+     */
+    bool allocate(size_t bytes, uint64_t& offset) const;
+
+   public:
+    /**
+     * @brief Open or create a cache file
+     *
+     * @param path cache file, its directory is created if missing
+     * @param capacity bytes of thumbnail data kept
+     * @param entries maximum number of thumbnails kept
+     *
+     * @details
+     * A file that cannot be opened leaves the cache disabled: lookups miss
+     * and inserts do nothing. A file written with another layout or size is
+     * reset.
+     */
+    explicit ThumbnailCache(const std::string& path,
+                            size_t capacity = DEFAULT_CAPACITY,
+                            uint32_t entries = DEFAULT_ENTRIES);
+
+    // ThumbnailCache is non-copyable and non-movable, it owns the mapping
+    ThumbnailCache(const ThumbnailCache& other) = delete;
+    ThumbnailCache& operator=(ThumbnailCache const& other) = delete;
+    ThumbnailCache(ThumbnailCache&& other) noexcept = delete;
+    ThumbnailCache& operator=(ThumbnailCache&& other) noexcept = delete;
+
+    ~ThumbnailCache();
+
+    /**
+     * @brief Whether the cache file is open.
+     */
+    bool isOpen() const noexcept { return map != nullptr; }
+
+    /**
+     * @brief Hashes an encoded image with 64-bit FNV-1a.
+     *
+     * @param data encoded image
+     * @param size size of the encoded image in bytes
+     * @param variant hashed after the image, so thumbnails of one image
+     * built in different ways, such as with another resize filter, are
+     * kept apart
+     * @return uint64_t the hash
+     */
+    static uint64_t hash(const unsigned char* data, size_t size,
+                         uint8_t variant = 0) noexcept;
+
+    /**
+     * @brief Looks up a thumbnail.
+     *
+     * @param hash hash() of the encoded image
+     * @param sourceSize size of the encoded image in bytes
+     * @param w thumbnail width in pixels
+     * @param h thumbnail height in pixels
+     * @param rgba receives w * h RGBA pixels on a hit
+     * @return true if the thumbnail was cached
+     */
+    bool lookup(uint64_t hash, uint64_t sourceSize, uint32_t w, uint32_t h,
+                std::vector<unsigned char>& rgba);
+
+    /**
+     * @brief Stores a thumbnail, evicting the least recently used ones if
+     * there is no room.
+     *
+     * @param hash hash() of the encoded image
+     * @param sourceSize size of the encoded image in bytes
+     * @param w thumbnail width in pixels
+     * @param h thumbnail height in pixels
+     * @param rgba w * h RGBA pixels
+     */
+    void insert(uint64_t hash, uint64_t sourceSize, uint32_t w, uint32_t h,
+                const unsigned char* rgba);
+
+    /**
+     * @brief Returns the default cache file, under $XDG_CACHE_HOME or
+     * ~/.cache.
+     *
+     * @return std::string path, empty if neither is set
+     */
+    static std::string defaultPath();
+};
@@ -18,8 +18,10 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 
 #include "../ColoredChar/ColoredChar.h"
+#include "../Renderer/Surface/Surface.h"
 
 /**
  * @class Component
@@ -38,6 +40,14 @@ class Component {
     uint32_t width;
     uint32_t height;
 
+    static constexpr ClipRect ALL_CELLS{0, 0,
+                                        std::numeric_limits<int32_t>::max(),
+                                        std::numeric_limits<int32_t>::max()};
+
+    bool dirty = true;               // Changed since it was last drawn
+    ClipRect dirtyArea = ALL_CELLS;  // Local area that changed
+    ClipRect drawnRect{};            // Frame area it covered when last drawn
+
    public:
     Component() = default;
     Component(int32_t xCoord, int32_t yCoord)
@@ -62,6 +72,74 @@ class Component {
     void setX(uint32_t xCoord) noexcept { x = xCoord; }
     void setY(uint32_t yCoord) noexcept { y = yCoord; }
 
+    /**
+     * @brief Flags the component for the next partial redraw.
+     *
+     * @details
+     * Only needed for changes followed by Renderer::requestPartialRedraw(); a
+     * full redraw draws every component regardless.
+     */
+    void markDirty() noexcept {
+        dirty = true;
+        dirtyArea = ALL_CELLS;
+    }
+
+    /**
+     * @brief Flags part of the component for the next partial redraw.
+     *
+     * @param area changed cells in local coordinates
+     *
+     * @details
+     * If the component did not move or resize since it was last drawn, only
+     * this area is redrawn. Repeated calls accumulate.
+     */
+    void markDirty(const ClipRect& area) noexcept {
+        dirtyArea = dirty ? dirtyArea.unite(area) : area;
+        dirty = true;
+    }
+
+    bool isDirty() const noexcept { return dirty; }
+
+    /**
+     * @brief Returns the changed area in local coordinates, clipped to the
+     * component.
+     */
+    ClipRect getDirtyArea() const noexcept {
+        return dirtyArea.intersect({0, 0, static_cast<int32_t>(width),
+                                    static_cast<int32_t>(height)});
+    }
+
+    /**
+     * @brief Records what the renderer drew and clears the dirty flag.
+     *
+     * @param rect frame area the component covered
+     */
+    void markDrawn(const ClipRect& rect) noexcept {
+        drawnRect = rect;
+        dirty = false;
+        dirtyArea = {};
+    }
+
+    /**
+     * @brief Returns the frame area the component covered when last drawn.
+     */
+    const ClipRect& getDrawnRect() const noexcept { return drawnRect; }
+
+    /**
+     * @brief Resizes the component.
+     *
+     * @param w new width
+     * @param h new height
+     *
+     * @details
+     * Called by layouts that size components to their slot. Components that
+     * cache anything derived from their size should override this.
+     */
+    virtual void resize(uint32_t w, uint32_t h) {
+        width = w;
+        height = h;
+    }
+
     /**
      * @brief Returns the rendered character at a local coordinate.
      *
@@ -75,5 +153,19 @@ class Component {
      * component's visible region.
      */
     virtual ColoredChar pixelAt(int32_t x, int32_t y) const = 0;
+
+    /**
+     * @brief Draws the component into a surface.
+     *
+     * @param surface surface whose local coordinates the component's position
+     * is relative to
+     *
+     * @details
+     * The default copies pixelAt() for every visible cell. Built-in components
+     * override this with a final version so the per-cell call is inlined.
+     */
+    virtual void blit(const Surface& surface) const {
+        blitPixels(*this, surface);
+    }
 };
 
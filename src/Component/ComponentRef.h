@@ -0,0 +1,47 @@
+/**
+ * @file ComponentRef.h
+ * @author Amin Karic
+ * @brief Typed, non-owning reference to a component.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * ComponentRef is a variant of pointers to the built-in component types plus a
+ * plain Component pointer for custom components. Visiting a ComponentRef gives
+ * the caller the concrete type, so render code for built-in components is
+ * statically dispatched and can be inlined instead of going through a virtual
+ * pixelAt() call per cell.
+ */
+#pragma once
+
+#include <variant>
+
+class Component;
+class Text;
+class SeekBar;
+class AlbumAsciiArt;
+class ListView;
+class Viewport;
+
+/**
+ * @brief Non-owning reference to a component in a Menu.
+ *
+ * @note
+ * The Component* alternative is used for custom components added through
+ * Menu::addComponent() and is always rendered through the virtual interface.
+ */
+using ComponentRef = std::variant<Component*, Text*, SeekBar*, AlbumAsciiArt*,
+                                  ListView*, Viewport*>;
+
+/**
+ * @brief Returns the component a ComponentRef points to as a Component*.
+ *
+ * @note
+ * This is a template only so that it is instantiated where it is used; the
+ * component types must be complete at the call site.
+ */
+template <typename Ref = ComponentRef>
+inline Component* toComponent(const Ref& ref) {
+    return std::visit([](auto* c) -> Component* { return c; }, ref);
+}
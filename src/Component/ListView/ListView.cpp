@@ -0,0 +1,242 @@
+/**
+ * @file ListView.cpp
+ * @author Amin Karic
+ * @brief ListView component implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for ListView class.
+ */
+
+#include "ListView.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../Unicode/DisplayWidth/DisplayWidth.h"
+#include "../../Unicode/Grapheme/Grapheme.h"
+
+ListView::ListView(std::allocator_arg_t, const allocator_type& alloc,
+                   int32_t x, int32_t y, uint32_t w, uint32_t h,
+                   RowCountFn rowCount, RowFormatFn formatRow,
+                   size_t cacheCapacity)
+    : Component(x, y, w, h),
+      rowCount(std::move(rowCount)),
+      formatRow(std::move(formatRow)),
+      cacheCapacity(cacheCapacity),
+      cache(alloc),
+      cacheIndex(alloc),
+      window(alloc) {
+    refresh();
+}
+
+const std::pmr::u32string& ListView::fetchRow(size_t row) {
+    auto found = cacheIndex.find(row);
+    if (found != cacheIndex.end()) {
+        // Move the hit to the front of the LRU list
+        cache.splice(cache.begin(), cache, found->second);
+        return found->second->text;
+    }
+
+    // The visible rows were fetched most recently, so keeping at least one
+    // window of rows guarantees they are never evicted while being drawn
+    size_t capacity = std::max<size_t>(cacheCapacity, getHeight());
+    while (cache.size() >= capacity && !cache.empty()) {
+        cacheIndex.erase(cache.back().row);
+        cache.pop_back();
+    }
+
+    // Decode into scratch buffers that keep their capacity, so only the
+    // cached copy is allocated, from the list's allocator
+    thread_local std::u32string decoded;
+    thread_local std::u32string cells;
+    std::string utf8 = formatRow ? formatRow(row) : std::string();
+    decodeUTF8(utf8, decoded);
+    // Rows are single line, so control characters are drawn as spaces
+    for (char32_t& c : decoded) {
+        if (c < 0x20) {
+            c = U' ';
+        }
+    }
+    // The row cache already keeps the result, so segment directly
+    const std::u32string* text = &decoded;
+    if (!isTriviallySegmented(decoded.data(), decoded.size())) {
+        segmentGraphemes(decoded.data(), decoded.size(), cells);
+        text = &cells;
+    }
+
+    cache.push_front(CachedRow{
+        row, std::pmr::u32string(text->begin(), text->end(),
+                                 window.get_allocator())});
+    cacheIndex[row] = cache.begin();
+    return cache.front().text;
+}
+
+void ListView::rebuildWindow() {
+    size_t w = getWidth();
+    size_t h = getHeight();
+    window.assign(w * h, ColoredChar(U' ', rowColor));
+
+    for (size_t y = 0; y < h && topRow + y < count; ++y) {
+        const std::pmr::u32string& text = fetchRow(topRow + y);
+        ColoredChar* out = window.data() + y * w;
+        size_t x = 0;
+        for (char32_t c : text) {
+            // Wide characters take a second, continuation cell and stop the
+            // row rather than being split at its end
+            uint32_t cells = displayWidth(c);
+            if (cells == 0) {
+                continue;
+            }
+            if (x + cells > w) {
+                break;
+            }
+            out[x].c = c;
+            if (cells == 2) {
+                out[x + 1].c = CCHAR_CONTINUATION;
+            }
+            x += cells;
+        }
+    }
+}
+
+void ListView::scrollToSelection() {
+    size_t h = getHeight();
+    if (selected < topRow) {
+        topRow = selected;
+    } else if (h > 0 && selected >= topRow + h) {
+        topRow = selected - h + 1;
+    }
+}
+
+void ListView::markRowDirty(size_t row) {
+    if (row < topRow || row - topRow >= getHeight()) {
+        return;
+    }
+    int32_t y = static_cast<int32_t>(row - topRow);
+    markDirty({0, y, static_cast<int32_t>(getWidth()), y + 1});
+}
+
+void ListView::refresh() {
+    count = rowCount ? rowCount() : 0;
+    cache.clear();
+    cacheIndex.clear();
+
+    if (selected >= count) {
+        selected = count == 0 ? 0 : count - 1;
+    }
+    size_t h = getHeight();
+    if (topRow + h > count) {
+        topRow = count > h ? count - h : 0;
+    }
+    scrollToSelection();
+    rebuildWindow();
+    markDirty();
+}
+
+void ListView::invalidateRow(size_t row) {
+    auto found = cacheIndex.find(row);
+    if (found != cacheIndex.end()) {
+        cache.erase(found->second);
+        cacheIndex.erase(found);
+    }
+    if (row >= topRow && row < topRow + getHeight()) {
+        rebuildWindow();
+        markRowDirty(row);
+    }
+}
+
+void ListView::resize(uint32_t w, uint32_t h) {
+    bool resized = w != getWidth() || h != getHeight();
+    size_t oldTop = topRow;
+    setWidth(w);
+    setHeight(h);
+    if (topRow + h > count) {
+        topRow = count > h ? count - h : 0;
+    }
+    scrollToSelection();
+    rebuildWindow();
+    if (resized || topRow != oldTop) {
+        markDirty();
+    }
+}
+
+void ListView::moveSelection(int64_t delta) {
+    if (count == 0) {
+        return;
+    }
+    int64_t target = static_cast<int64_t>(selected) + delta;
+    target = std::clamp<int64_t>(target, 0, static_cast<int64_t>(count) - 1);
+    select(static_cast<size_t>(target));
+}
+
+void ListView::select(size_t row) {
+    if (count == 0) {
+        return;
+    }
+    size_t oldSelected = selected;
+    selected = std::min(row, count - 1);
+
+    size_t oldTop = topRow;
+    scrollToSelection();
+    if (topRow != oldTop) {
+        rebuildWindow();
+        markDirty();
+    } else if (selected != oldSelected) {
+        // Only the highlight moved
+        markRowDirty(oldSelected);
+        markRowDirty(selected);
+    }
+}
+
+void ListView::scrollBy(int64_t delta) {
+    size_t h = getHeight();
+    int64_t maxTop = count > h ? static_cast<int64_t>(count - h) : 0;
+    int64_t target = static_cast<int64_t>(topRow) + delta;
+    target = std::clamp<int64_t>(target, 0, maxTop);
+
+    if (static_cast<size_t>(target) != topRow) {
+        topRow = static_cast<size_t>(target);
+        rebuildWindow();
+        markDirty();
+    }
+}
+
+bool ListView::handleKey(char key) {
+    switch (key) {
+        case 'j':
+            moveSelection(1);
+            return true;
+        case 'k':
+            moveSelection(-1);
+            return true;
+        case 'J':
+            pageDown();
+            return true;
+        case 'K':
+            pageUp();
+            return true;
+        case 'g':
+            selectFirst();
+            return true;
+        case 'G':
+            selectLast();
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ListView::setColors(uint32_t row, uint32_t selFG, uint32_t selBG) {
+    if (row == rowColor && selFG == selectedFG && selBG == selectedBG) {
+        return;
+    }
+    rowColor = row;
+    selectedFG = selFG;
+    selectedBG = selBG;
+    for (auto& cell : window) {
+        cell.rgba_fg = rowColor;
+    }
+    markDirty();
+}
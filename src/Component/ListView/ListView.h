@@ -0,0 +1,277 @@
+/**
+ * @file ListView.h
+ * @author Amin Karic
+ * @brief ListView component definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * This class is a scrollable list of rows supplied by a data source callback.
+ * Only the rows inside the visible window are formatted and stored, so the
+ * cost of scrolling does not depend on the number of rows in the list.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../ColoredChar/ColoredChar.h"
+#include "../Component.h"
+
+/**
+ * @class ListView
+ *
+ * @brief Virtualized list component with keyboard scrolling and selection.
+ *
+ * @details
+ * The data source is a pair of callbacks: one returning the number of rows and
+ * one formatting a row by index. Formatted rows are decoded once and kept in a
+ * small LRU cache, and the visible rows are copied into a window buffer that
+ * pixelAt() reads from directly.
+ *
+ * Call refresh() after the underlying data changes.
+ *
+ * ListView is allocator-aware: when constructed inside a Menu's pool its row
+ * cache and window are allocated from the menu's arena.
+ */
+class ListView : public Component {
+   public:
+    using RowCountFn = std::function<size_t()>;
+    using RowFormatFn = std::function<std::string(size_t)>;
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+   private:
+    /**
+     * @brief A formatted and decoded row held in the LRU cache.
+     */
+    struct CachedRow {
+        size_t row;
+        std::pmr::u32string text;
+    };
+
+    RowCountFn rowCount;    // Returns the number of rows in the data source
+    RowFormatFn formatRow;  // Returns the text of a row by index
+    size_t count = 0;       // Row count at the last refresh()
+    size_t topRow = 0;      // Index of the first visible row
+    size_t selected = 0;    // Index of the selected row
+
+    uint32_t rowColor = CCHAR_WHITE;          // Color of unselected rows
+    uint32_t selectedFG = CCHAR_BLACK;        // Selected row foreground
+    uint32_t selectedBG = CCHAR_WHITE;        // Selected row background
+
+    size_t cacheCapacity;                     // Maximum rows in the cache
+    std::pmr::list<CachedRow> cache;          // Most recently used first
+    std::pmr::unordered_map<size_t, std::pmr::list<CachedRow>::iterator>
+        cacheIndex;                           // Row index to cache entry
+
+    std::pmr::vector<ColoredChar> window;  // width * height cells in view
+
+    /**
+     * @brief Returns the decoded text of a row, formatting it on a cache miss.
+     */
+    const std::pmr::u32string& fetchRow(size_t row);
+
+    /**
+     * @brief Rebuilds the window buffer from the rows currently in view.
+     */
+    void rebuildWindow();
+
+    /**
+     * @brief Adjusts topRow so that the selected row is visible.
+     */
+    void scrollToSelection();
+
+    /**
+     * @brief Marks a row for the next partial redraw if it is in view.
+     */
+    void markRowDirty(size_t row);
+
+   public:
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = 256;
+
+    ListView() : ListView(std::allocator_arg, allocator_type()) {}
+
+    /**
+     * @brief Construct an empty ListView object using the given allocator.
+     *
+     * @param alloc allocator for the row cache and window
+     */
+    ListView(std::allocator_arg_t, const allocator_type& alloc)
+        : cacheCapacity(DEFAULT_CACHE_CAPACITY),
+          cache(alloc),
+          cacheIndex(alloc),
+          window(alloc) {}
+
+    /**
+     * @brief Construct a new ListView object
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param w width of the list in cells
+     * @param h number of visible rows
+     * @param rowCount callback returning the number of rows
+     * @param formatRow callback returning the UTF-8 text of a row
+     * @param cacheCapacity number of formatted rows to keep cached
+     */
+    explicit ListView(int32_t x, int32_t y, uint32_t w, uint32_t h,
+                      RowCountFn rowCount, RowFormatFn formatRow,
+                      size_t cacheCapacity = DEFAULT_CACHE_CAPACITY)
+        : ListView(std::allocator_arg, allocator_type(), x, y, w, h,
+                   std::move(rowCount), std::move(formatRow), cacheCapacity) {
+    }
+
+    /**
+     * @brief Construct a new ListView object using the given allocator.
+     *
+     * @param alloc allocator for the row cache and window
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param w width of the list in cells
+     * @param h number of visible rows
+     * @param rowCount callback returning the number of rows
+     * @param formatRow callback returning the UTF-8 text of a row
+     * @param cacheCapacity number of formatted rows to keep cached
+     */
+    ListView(std::allocator_arg_t, const allocator_type& alloc, int32_t x,
+             int32_t y, uint32_t w, uint32_t h, RowCountFn rowCount,
+             RowFormatFn formatRow,
+             size_t cacheCapacity = DEFAULT_CACHE_CAPACITY);
+
+    // The cache index holds iterators into the cache, so copies would point
+    // into the wrong list. So would a move assignment between arenas, which
+    // moves the rows one by one into new nodes.
+    ListView(const ListView& other) = delete;
+    ListView& operator=(const ListView& other) = delete;
+    ListView(ListView&& other) noexcept = default;
+    ListView& operator=(ListView&& other) = delete;
+
+    ~ListView() = default;
+
+    /**
+     * @brief Re-reads the row count and drops all cached rows.
+     *
+     * @details
+     * Call this after the data source changes. The selection is clamped to
+     * the new row count.
+     */
+    void refresh();
+
+    /**
+     * @brief Drops a single cached row so it is formatted again.
+     *
+     * @param row index of the row that changed
+     */
+    void invalidateRow(size_t row);
+
+    /**
+     * @brief Resizes the visible area of the list.
+     *
+     * @param w width in cells
+     * @param h number of visible rows
+     */
+    void resize(uint32_t w, uint32_t h) override;
+
+    /**
+     * @brief Moves the selection by @p delta rows, scrolling to keep it
+     * visible.
+     *
+     * @param delta number of rows to move, negative moves up
+     */
+    void moveSelection(int64_t delta);
+
+    /**
+     * @brief Selects a row by index, scrolling to keep it visible.
+     *
+     * @param row index of the row to select, clamped to the row count
+     */
+    void select(size_t row);
+
+    /**
+     * @brief Scrolls the view by @p delta rows without moving the selection.
+     *
+     * @param delta number of rows to scroll, negative scrolls up
+     */
+    void scrollBy(int64_t delta);
+
+    void pageUp() { moveSelection(-static_cast<int64_t>(getHeight())); }
+    void pageDown() { moveSelection(static_cast<int64_t>(getHeight())); }
+    void selectFirst() { select(0); }
+    void selectLast() { select(count == 0 ? 0 : count - 1); }
+
+    /**
+     * @brief Handles a hotkey for list navigation.
+     *
+     * @param key 'j'/'k' move down/up, 'J'/'K' page down/up, 'g'/'G' jump to
+     * first/last row
+     * @return true the key was handled
+     * @return false the key is not a list key
+     */
+    bool handleKey(char key);
+
+    size_t getSelected() const noexcept { return selected; }
+    size_t getTopRow() const noexcept { return topRow; }
+    size_t getRowCount() const noexcept { return count; }
+
+    /**
+     * @brief Sets the colors used to draw rows.
+     *
+     * @param row foreground color of unselected rows
+     * @param selFG foreground color of the selected row
+     * @param selBG background color of the selected row
+     */
+    void setColors(uint32_t row, uint32_t selFG, uint32_t selBG);
+
+    /**
+     * @brief Get the allocator used for the row cache and window
+     *
+     * @return allocator_type
+     */
+    allocator_type get_allocator() const noexcept {
+        return window.get_allocator();
+    }
+
+    /**
+     * @brief Return the ColoredChar at given pixel coordinates
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @return ColoredChar colored character at (x, y), BLANK_CHARACTER if out
+     * of bounds
+     */
+    virtual ColoredChar pixelAt(int32_t x,
+                                int32_t y) const noexcept override final {
+        if (x < 0 || y < 0 || x >= static_cast<int>(getWidth()) ||
+            y >= static_cast<int>(getHeight())) {
+            return BLANK_CHARACTER;
+        }
+
+        size_t index = static_cast<size_t>(y) * getWidth() + x;
+        if (index >= window.size()) {
+            return BLANK_CHARACTER;
+        }
+
+        ColoredChar cell = window[index];
+        if (topRow + static_cast<size_t>(y) == selected && selected < count) {
+            cell.rgba_fg = selectedFG;
+            cell.rgba_bg = selectedBG;
+        }
+        return cell;
+    }
+
+    /**
+     * @brief Draws the component into a surface with pixelAt() inlined.
+     *
+     * @param surface surface to draw into
+     */
+    virtual void blit(const Surface& surface) const override final {
+        blitPixels(*this, surface);
+    }
+};
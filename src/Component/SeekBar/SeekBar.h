@@ -24,7 +24,9 @@
  */
 class SeekBar : public Component {
    private:
-    uint8_t progress;  // Progress in percentage [0, 100]
+    uint8_t progress;                // Progress in percentage [0, 100]
+    uint32_t fillColor = CCHAR_WHITE;  // Played part and dot
+    uint32_t trackColor = 0x424242FF;  // Remaining part, dark gray
    public:
     SeekBar() = default;
     /**
@@ -59,6 +61,26 @@ class SeekBar : public Component {
 
     uint8_t getProgress() const { return progress; };
 
+    /**
+     * @brief Sets the colors of the bar and marks it dirty if they changed,
+     * e.g. to accents taken from the album art.
+     *
+     * @param fill color of the played part and the dot
+     * @param track color of the remaining part
+     */
+    void setColors(uint32_t fill, uint32_t track) {
+        if (fill == fillColor && track == trackColor) {
+            return;
+        }
+        fillColor = fill;
+        trackColor = track;
+        markDirty();
+    }
+
+    uint32_t getFillColor() const noexcept { return fillColor; }
+
+    uint32_t getTrackColor() const noexcept { return trackColor; }
+
     /**
      * @brief Return the ColoredChar at given pixel coordinates
      *
@@ -78,10 +100,19 @@ class SeekBar : public Component {
         int32_t filledWidth = (getWidth() * progress) / 100;
 
         if (x < filledWidth) {
-            return ColoredChar(U'─', CCHAR_WHITE);
+            return ColoredChar(U'─', fillColor);
         } else if (x == filledWidth) {
-            return ColoredChar(U'*', CCHAR_WHITE);  // Seek bar dot
+            return ColoredChar(U'*', fillColor);  // Seek bar dot
         }
-        return ColoredChar(U'─', 0x424242FF);  // Dark gray color
+        return ColoredChar(U'─', trackColor);
     };
+
+    /**
+     * @brief Draws the component into a surface with pixelAt() inlined.
+     *
+     * @param surface surface to draw into
+     */
+    virtual void blit(const Surface& surface) const override final {
+        blitPixels(*this, surface);
+    }
 };
\ No newline at end of file
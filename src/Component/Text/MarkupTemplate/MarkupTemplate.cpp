@@ -0,0 +1,249 @@
+/**
+ * @file MarkupTemplate.cpp
+ * @author Amin Karic
+ * @brief MarkupTemplate implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for MarkupTemplate class.
+ */
+
+#include "MarkupTemplate.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+
+/**
+ * @brief Style in effect at a point of the template.
+ */
+struct StyleState {
+    std::string tag;  // Tag that opened this state
+    uint32_t fg;
+    uint32_t bg;
+    uint8_t attrs;
+};
+
+std::optional<uint32_t> parseColor(const std::string& value) {
+    static const std::pair<const char*, uint32_t> NAMES[] = {
+        {"white", CCHAR_WHITE},     {"black", CCHAR_BLACK},
+        {"red", CCHAR_RED},         {"green", CCHAR_GREEN},
+        {"blue", CCHAR_BLUE},       {"yellow", CCHAR_YELLOW},
+        {"cyan", CCHAR_CYAN},       {"magenta", CCHAR_MAGENTA},
+        {"default", CCHAR_DEFAULT},
+    };
+    for (const auto& name : NAMES) {
+        if (value == name.first) {
+            return name.second;
+        }
+    }
+
+    if (value.size() != 7 && value.size() != 9) {
+        return std::nullopt;
+    }
+    if (value[0] != '#') {
+        return std::nullopt;
+    }
+    uint32_t rgba = 0;
+    for (size_t i = 1; i < value.size(); ++i) {
+        char c = value[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+        } else {
+            return std::nullopt;
+        }
+        rgba = (rgba << 4) | digit;
+    }
+    return value.size() == 7 ? (rgba << 8) | 0xFF : rgba;
+}
+
+// Applies an opening tag to a style, returns false for unknown tags
+bool applyTag(const std::string& tag, StyleState& state) {
+    static const std::pair<const char*, uint8_t> ATTRIBUTES[] = {
+        {"b", CCHAR_BOLD},      {"dim", CCHAR_DIM},
+        {"i", CCHAR_ITALIC},    {"u", CCHAR_UNDERLINE},
+        {"rev", CCHAR_REVERSE},
+    };
+    for (const auto& attribute : ATTRIBUTES) {
+        if (tag == attribute.first) {
+            state.tag = tag;
+            state.attrs |= attribute.second;
+            return true;
+        }
+    }
+
+    size_t equals = tag.find('=');
+    if (equals == std::string::npos) {
+        return false;
+    }
+    std::string name = tag.substr(0, equals);
+    std::optional<uint32_t> color = parseColor(tag.substr(equals + 1));
+    if (!color || (name != "fg" && name != "bg")) {
+        return false;
+    }
+    state.tag = name;
+    (name == "fg" ? state.fg : state.bg) = *color;
+    return true;
+}
+
+}  // namespace
+
+MarkupTemplate::MarkupTemplate(const std::string& markup, uint32_t color) {
+    compile(markup, color);
+}
+
+void MarkupTemplate::compile(const std::string& markup, uint32_t color) {
+    std::u32string source = decodeUTF8(markup);
+    std::vector<StyleState> styles{{"", color, CCHAR_DEFAULT, 0}};
+
+    // Literal text is accumulated until the style changes or a slot starts
+    size_t literalStart = 0;
+    auto flushLiteral = [&]() {
+        if (literals.size() > literalStart) {
+            const StyleState& s = styles.back();
+            segments.push_back({LITERAL, literalStart,
+                                literals.size() - literalStart, s.fg, s.bg,
+                                s.attrs});
+        }
+        literalStart = literals.size();
+    };
+
+    size_t i = 0;
+    while (i < source.size()) {
+        char32_t c = source[i];
+        bool escaped = i + 1 < source.size() && source[i + 1] == c;
+        if ((c == U'[' || c == U'{') && escaped) {
+            literals.push_back(c);
+            i += 2;
+            continue;
+        }
+
+        char32_t close = c == U'[' ? U']' : c == U'{' ? U'}' : 0;
+        size_t end = close != 0 ? source.find(close, i + 1) : std::u32string::npos;
+        if (end == std::u32string::npos) {
+            literals.push_back(c);
+            ++i;
+            continue;
+        }
+
+        // Tag and slot names are ASCII, anything else is kept as text
+        std::string name;
+        bool ascii = true;
+        for (size_t j = i + 1; j < end; ++j) {
+            ascii &= source[j] < 0x80;
+            name.push_back(static_cast<char>(source[j]));
+        }
+        if (!ascii) {
+            literals.push_back(c);
+            ++i;
+            continue;
+        }
+
+        if (c == U'{') {
+            flushLiteral();
+            auto found = std::find(slotNames.begin(), slotNames.end(), name);
+            size_t slot = static_cast<size_t>(found - slotNames.begin());
+            if (found == slotNames.end()) {
+                slotNames.push_back(name);
+                values.emplace_back();
+            }
+            const StyleState& s = styles.back();
+            segments.push_back({slot, 0, 0, s.fg, s.bg, s.attrs});
+            i = end + 1;
+            continue;
+        }
+
+        if (!name.empty() && name[0] == '/') {
+            // Close the most recent matching tag, or the most recent tag
+            std::string tag = name.substr(1);
+            for (size_t depth = styles.size() - 1; depth > 0; --depth) {
+                if (tag.empty() || styles[depth].tag == tag) {
+                    flushLiteral();
+                    styles.resize(depth);
+                    break;
+                }
+            }
+            i = end + 1;
+            continue;
+        }
+
+        StyleState next = styles.back();
+        if (!applyTag(name, next)) {
+            literals.push_back(c);
+            ++i;
+            continue;
+        }
+        flushLiteral();
+        styles.push_back(next);
+        i = end + 1;
+    }
+    flushLiteral();
+}
+
+size_t MarkupTemplate::getSlot(const std::string& name) const {
+    return static_cast<size_t>(
+        std::find(slotNames.begin(), slotNames.end(), name) -
+        slotNames.begin());
+}
+
+void MarkupTemplate::setValue(size_t slot, const std::string& value) {
+    if (slot >= values.size()) {
+        return;
+    }
+    decodeUTF8(value, values[slot]);
+}
+
+bool MarkupTemplate::setValue(const std::string& name,
+                              const std::string& value) {
+    size_t slot = getSlot(name);
+    if (slot >= values.size()) {
+        return false;
+    }
+    setValue(slot, value);
+    return true;
+}
+
+void MarkupTemplate::apply(Text& text) {
+    scratchText.clear();
+    scratchRuns.clear();
+    size_t cells = 0;  // Characters excluding newlines, what runs index
+
+    for (const Segment& segment : segments) {
+        const char32_t* begin;
+        size_t length;
+        if (segment.slot == LITERAL) {
+            begin = literals.data() + segment.literalStart;
+            length = segment.literalLength;
+        } else {
+            begin = values[segment.slot].data();
+            length = values[segment.slot].size();
+        }
+
+        StyleRun style{cells, 0, segment.fg, segment.bg, segment.attrs};
+        for (size_t i = 0; i < length; ++i) {
+            scratchText.push_back(begin[i]);
+            if (begin[i] != U'\n') {
+                ++style.length;
+            }
+        }
+        if (style.length == 0) {
+            continue;
+        }
+        cells += style.length;
+
+        if (!scratchRuns.empty() && scratchRuns.back().sameStyle(style)) {
+            scratchRuns.back().length += style.length;
+        } else {
+            scratchRuns.push_back(style);
+        }
+    }
+
+    text.rebuildStyled(scratchText, scratchRuns);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file MarkupTemplate.h
+ * @author Amin Karic
+ * @brief MarkupTemplate class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A MarkupTemplate is a line of styled text written with lightweight tags and
+ * compiled once into decoded literal segments with their styles. Named slots
+ * in the template are filled in later, so a line such as
+ * "[b]{elapsed}[/b] / {total}" is parsed once and each update only decodes
+ * the changed value and rewrites the Text in place.
+ *
+ * Supported tags, closed with [/tag] or [/] for the most recent one:
+ * - [b] bold, [dim] dim, [i] italic, [u] underline, [rev] reverse
+ * - [fg=COLOR] foreground, [bg=COLOR] background, where COLOR is #RRGGBB,
+ *   #RRGGBBAA, a name (white, black, red, green, blue, yellow, cyan, magenta)
+ *   or "default" for the terminal's color
+ *
+ * {name} inserts the value of a slot. "[[" and "{{" produce a literal '[' and
+ * '{'. Unknown tags are kept as text and unmatched closing tags are ignored.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Text.h"
+
+/**
+ * @class MarkupTemplate
+ *
+ * @brief Compiled styled text with substitutable slots.
+ */
+class MarkupTemplate {
+   private:
+    static constexpr size_t LITERAL = SIZE_MAX;  // Segment is not a slot
+
+    /**
+     * @brief A piece of the template with a single style.
+     */
+    struct Segment {
+        size_t slot;           // Slot index, LITERAL for literal text
+        size_t literalStart;   // Start in literals for literal text
+        size_t literalLength;  // Length in literals for literal text
+        uint32_t fg;
+        uint32_t bg;
+        uint8_t attrs;
+    };
+
+    std::u32string literals;              // Decoded literal text
+    std::vector<Segment> segments;        // Template in order
+    std::vector<std::string> slotNames;   // Slot names by index
+    std::vector<std::u32string> values;   // Decoded slot values by index
+    std::u32string scratchText;           // Reused by apply()
+    std::vector<StyleRun> scratchRuns;    // Reused by apply()
+
+    /**
+     * @brief Parses the markup into segments.
+     */
+    void compile(const std::string& markup, uint32_t color);
+
+   public:
+    /**
+     * @brief Compile a new MarkupTemplate
+     *
+     * @param markup template text
+     * @param color foreground color of untagged text, malformed UTF-8 is
+     * shown as U+FFFD
+     */
+    explicit MarkupTemplate(const std::string& markup,
+                            uint32_t color = CCHAR_WHITE);
+
+    MarkupTemplate(const MarkupTemplate& other) = default;
+    MarkupTemplate& operator=(const MarkupTemplate& other) = default;
+    MarkupTemplate(MarkupTemplate&& other) noexcept = default;
+    MarkupTemplate& operator=(MarkupTemplate&& other) noexcept = default;
+
+    ~MarkupTemplate() = default;
+
+    /**
+     * @brief Get the number of distinct slots in the template
+     */
+    size_t getSlotCount() const noexcept { return slotNames.size(); }
+
+    /**
+     * @brief Get the index of a slot
+     *
+     * @param name slot name as written between braces
+     * @return size_t slot index, getSlotCount() if there is no such slot
+     */
+    size_t getSlot(const std::string& name) const;
+
+    /**
+     * @brief Set the value of a slot by index
+     *
+     * @param slot slot index, ignored if out of range
+     * @param value new value, decoded only here
+     */
+    void setValue(size_t slot, const std::string& value);
+
+    /**
+     * @brief Set the value of a slot by name
+     *
+     * @param name slot name
+     * @param value new value
+     * @return true if the slot exists
+     * @return false otherwise
+     */
+    bool setValue(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Write the template with the current values into a Text
+     *
+     * @param text Text to update, only cells that changed are marked dirty
+     */
+    void apply(Text& text);
+};
@@ -11,18 +11,125 @@
 
 #include "Text.h"
 
+#include "MarkupTemplate/MarkupTemplate.h"
+
+#include <algorithm>
 #include <cstdint>
+#include <string_view>
+
+#include "../../Unicode/Grapheme/Grapheme.h"
+#include "../../Unicode/Grapheme/GraphemeCache/GraphemeCache.h"
+
+namespace {
+
+/**
+ * @brief Returns the cells of decoded text, one per grapheme cluster.
+ *
+ * @return const std::u32string& @p text itself if no code points join,
+ * otherwise a scratch buffer valid until the next call on this thread
+ */
+const std::u32string& segmented(const std::u32string& text) {
+    if (isTriviallySegmented(text.data(), text.size())) {
+        return text;
+    }
+    thread_local std::u32string cells;
+    GraphemeCache::shared().segment(text, cells);
+    return cells;
+}
+
+/**
+ * @brief Moves runs over code points onto the clusters holding them.
+ *
+ * @details
+ * A cluster takes the style of its first code point, so runs that only
+ * cover the inside of a cluster disappear.
+ *
+ * @param cells segmented text, including its newlines
+ * @param styles runs covering the code points without newlines, in order
+ * @param out receives the runs over the cells without newlines
+ */
+void remapRuns(const std::u32string& cells,
+               const std::vector<StyleRun>& styles,
+               std::vector<StyleRun>& out) {
+    out.clear();
+    size_t next = 0;   // Next entry of cells
+    size_t cell = 0;   // Cells passed, without newlines
+    size_t point = 0;  // Code points passed, without newlines
+    for (const StyleRun& run : styles) {
+        // Skip the clusters that end before the run starts
+        while (next < cells.size()) {
+            if (cells[next] == U'\n') {
+                ++next;
+                continue;
+            }
+            size_t length = ClusterTable::length(cells[next]);
+            if (point + length > run.start) {
+                break;
+            }
+            point += length;
+            ++cell;
+            ++next;
+        }
+        // A run starting inside a cluster starts at the following one
+        size_t start = point == run.start ? cell : cell + 1;
+        if (!out.empty() && out.back().start == start) {
+            out.pop_back();
+        }
+        out.push_back(run);
+        out.back().start = start;
+    }
+
+    size_t total = cell;
+    for (; next < cells.size(); ++next) {
+        total += cells[next] != U'\n';
+    }
+    for (size_t i = 0; i < out.size(); ++i) {
+        size_t end = i + 1 < out.size() ? out[i + 1].start : total;
+        out[i].length = end - out[i].start;
+    }
+    if (!out.empty() && out.back().length == 0) {
+        out.pop_back();
+    }
+}
+
+}  // namespace
 
-Text::Text(int32_t xCoord, int32_t yCoord, const std::string& textContent,
-           uint8_t r, uint8_t g, uint8_t b)
-    : Component(xCoord, yCoord) {
+Text::Text(std::allocator_arg_t, const allocator_type& alloc, int32_t xCoord,
+           int32_t yCoord, const std::string& textContent, uint8_t r,
+           uint8_t g, uint8_t b)
+    : Component(xCoord, yCoord),
+      content(alloc),
+      runs(alloc),
+      lineBreaks(alloc),
+      lines(alloc) {
     uint32_t rgba = (static_cast<uint32_t>(r) << 24) |
                     (static_cast<uint32_t>(g) << 16) |
                     (static_cast<uint32_t>(b) << 8) | 0xFF;
     rebuildFromString(textContent, rgba);
 }
 
-void Text::paintFG(uint32_t color, size_t start, size_t n) {
+size_t Text::splitRunAt(size_t index) {
+    if (index >= content.size()) {
+        return runs.size();
+    }
+    auto after = std::upper_bound(
+        runs.begin(), runs.end(), index,
+        [](size_t value, const StyleRun& run) { return value < run.start; });
+    size_t i = static_cast<size_t>(after - runs.begin()) - 1;
+    if (runs[i].start == index) {
+        return i;
+    }
+
+    StyleRun tail = runs[i];
+    tail.start = index;
+    tail.length = runs[i].end() - index;
+    runs[i].length = index - runs[i].start;
+    runs.insert(runs.begin() + static_cast<std::ptrdiff_t>(i) + 1, tail);
+    return i + 1;
+}
+
+template <typename Change>
+void Text::restyle(size_t start, size_t n, Change&& change) {
     if (start >= content.size()) {
         return;
     }
@@ -31,52 +138,449 @@ void Text::paintFG(uint32_t color, size_t start, size_t n) {
         n = content.size() - start;
     }
 
-    for (size_t i = start; i < start + n; ++i) {
-        content[i].rgba_fg = color;
+    // Split so the range covers whole runs, then change only those
+    size_t first = splitRunAt(start);
+    size_t last = splitRunAt(start + n);
+    for (size_t i = first; i < last; ++i) {
+        change(runs[i]);
     }
+
+    // Merge runs that now share a style, including the neighbours
+    size_t from = first > 0 ? first - 1 : 0;
+    size_t to = std::min(last + 1, runs.size());
+    size_t out = from;
+    for (size_t i = from + 1; i < to; ++i) {
+        if (runs[out].sameStyle(runs[i])) {
+            runs[out].length += runs[i].length;
+        } else {
+            runs[++out] = runs[i];
+        }
+    }
+    runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(out) + 1,
+               runs.begin() + static_cast<std::ptrdiff_t>(to));
+
+    markDirty(contentArea(start, start + n - 1));
+}
+
+void Text::paintFG(uint32_t color, size_t start, size_t n) {
+    restyle(start, n, [color](StyleRun& run) { run.fg = color; });
 }
 
 void Text::paintBG(uint32_t color, size_t start, size_t n) {
-    // TODO: Implement behaivor
-    return;
+    restyle(start, n, [color](StyleRun& run) { run.bg = color; });
+}
+
+void Text::paintAttributes(uint8_t attributes, size_t start, size_t n) {
+    restyle(start, n,
+            [attributes](StyleRun& run) { run.attrs = attributes; });
+}
+
+template <typename NextChar>
+Text::ContentChange Text::writeContent(NextChar&& next) {
+    if (lineBreaks.empty()) {
+        lineBreaks.push_back(0);
+    }
+
+    // Write over the existing content and line breaks, only changing what
+    // differs
+    ContentChange change;
+    size_t oldSize = content.size();
+    size_t count = 0;       // Characters written so far
+    size_t paragraphs = 1;  // Line breaks written so far
+    bool breaksChanged = false;
+
+    char32_t c;
+    while (next(c)) {
+        // Ignore newlines in content for cleaner storage; we track line breaks
+        // separately
+        if (c == '\n') {
+            if (paragraphs < lineBreaks.size()) {
+                if (lineBreaks[paragraphs] != count) {
+                    lineBreaks[paragraphs] = count;
+                    breaksChanged = true;
+                }
+            } else {
+                lineBreaks.push_back(count);
+                breaksChanged = true;
+            }
+            ++paragraphs;
+            continue;
+        }
+
+        if (count < oldSize) {
+            if (content[count] != c) {
+                change.spacesChanged |= (content[count] == U' ') != (c == U' ');
+                change.widthsChanged |=
+                    displayWidth(content[count]) != displayWidth(c);
+                content[count] = c;
+                change.first = std::min(change.first, count);
+                change.last = count;
+            }
+        } else {
+            content.push_back(c);
+        }
+        ++count;
+    }
+
+    // Shrinking keeps the capacity for the next rebuild
+    if (paragraphs != lineBreaks.size()) {
+        lineBreaks.resize(paragraphs);
+        breaksChanged = true;
+    }
+    if (count != oldSize) {
+        content.resize(count);
+    }
+
+    change.reshaped = breaksChanged || count != oldSize;
+    return change;
+}
+
+bool Text::replaceRuns(const StyleRun* styles, size_t count) {
+    bool same = runs.size() == count;
+    for (size_t i = 0; same && i < count; ++i) {
+        same = runs[i].start == styles[i].start &&
+               runs[i].length == styles[i].length &&
+               runs[i].sameStyle(styles[i]);
+    }
+    if (same) {
+        return false;
+    }
+    runs.assign(styles, styles + count);
+    return true;
+}
+
+void Text::finishRebuild(const ContentChange& change, bool restyled) {
+    if (!change.reshaped && !restyled && change.first == SIZE_MAX) {
+        return;  // Same text, nothing to redraw
+    }
+
+    if (change.reshaped || restyled || marqueeWidth != 0 ||
+        change.widthsChanged ||
+        (change.spacesChanged && overflow == TextOverflow::Wrap)) {
+        if (change.reshaped) {
+            // New text starts scrolling from its beginning
+            marqueeOffset = 0;
+        }
+        if (change.reshaped || change.widthsChanged) {
+            measureWidths();
+        }
+        layoutLines();
+        markDirty();
+        return;
+    }
+
+    // Same shape, so only the changed cells need redrawing
+    markDirty(contentArea(change.first, change.last));
 }
 
 void Text::rebuildFromString(const std::string& text, uint32_t color) {
-    content.clear();
+    // Decode in bulk first, the scratch buffer keeps its capacity between
+    // rebuilds so steady updates do not allocate
+    thread_local std::u32string decoded;
+    decodeUTF8(text, decoded);
+    const std::u32string& cells = segmented(decoded);
+
+    size_t i = 0;
+    ContentChange change = writeContent([&cells, &i](char32_t& c) {
+        if (i >= cells.size()) {
+            return false;
+        }
+        c = cells[i++];
+        return true;
+    });
+
+    // The whole text takes the new color as a single run
+    StyleRun style{0, content.size(), color, CCHAR_DEFAULT, 0};
+    bool restyled = replaceRuns(&style, content.empty() ? 0 : 1);
+    finishRebuild(change, restyled);
+}
+
+void Text::rebuildStyled(const std::u32string& text,
+                         const std::vector<StyleRun>& styles) {
+    const std::u32string& cells = segmented(text);
+    size_t i = 0;
+    ContentChange change = writeContent([&cells, &i](char32_t& c) {
+        if (i >= cells.size()) {
+            return false;
+        }
+        c = cells[i++];
+        return true;
+    });
+
+    // Styles are given over code points, which only match the content if
+    // every cluster is a single code point
+    size_t points =
+        text.size() - std::count(text.begin(), text.end(), U'\n');
+    bool restyled;
+    if (!styles.empty() && styles.front().start == 0 &&
+        styles.back().end() == points) {
+        if (&cells == &text) {
+            restyled = replaceRuns(styles.data(), styles.size());
+        } else {
+            thread_local std::vector<StyleRun> remapped;
+            remapRuns(cells, styles, remapped);
+            restyled = replaceRuns(remapped.data(), remapped.size());
+        }
+    } else {
+        // Runs that do not cover the text would break lookups, fall back to
+        // the default style
+        StyleRun style{0, content.size(), CCHAR_WHITE, CCHAR_DEFAULT, 0};
+        restyled = replaceRuns(&style, content.empty() ? 0 : 1);
+    }
+    finishRebuild(change, restyled);
+}
+
+void Text::setMarkup(const std::string& markup) {
+    MarkupTemplate(markup).apply(*this);
+}
+
+void Text::rebuildFromString(const std::vector<ColoredChar>& text) {
+    rebuildCells(text.data(), text.size());
+}
+
+void Text::rebuildFromString(std::pmr::vector<ColoredChar>&& text) {
+    rebuildCells(text.data(), text.size());
+    text.clear();
+}
+
+void Text::rebuildCells(const ColoredChar* cells, size_t count) {
+    // Scratch buffers keep their capacity between rebuilds
+    thread_local std::u32string points;
+    thread_local std::vector<StyleRun> styles;
+    points.clear();
+    styles.clear();
+
+    size_t styled = 0;  // Code points passed, without newlines
+    for (size_t i = 0; i < count; ++i) {
+        const ColoredChar& cell = cells[i];
+        points.push_back(cell.c);
+        if (cell.c == U'\n') {
+            continue;
+        }
+        StyleRun style{styled++, 1, cell.rgba_fg, cell.rgba_bg, cell.attrs};
+        if (!styles.empty() && styles.back().sameStyle(style)) {
+            ++styles.back().length;
+        } else {
+            styles.push_back(style);
+        }
+    }
+    // Segmented and remapped onto the clusters like any other styled text
+    rebuildStyled(points, styles);
+}
+
+void Text::rebuildFromString(std::pmr::vector<char32_t>&& text,
+                             uint32_t color) {
+    content = std::move(text);
+    adoptContent();
+
+    runs.clear();
+    if (!content.empty()) {
+        runs.push_back({0, content.size(), color, CCHAR_DEFAULT, 0});
+    }
+}
+
+void Text::adoptContent() {
+    if (!isTriviallySegmented(content.data(), content.size())) {
+        // Clusters never outnumber code points, so they fit in place
+        thread_local std::u32string cells;
+        GraphemeCache::shared().segment(
+            std::u32string_view(content.data(), content.size()), cells);
+        content.assign(cells.begin(), cells.end());
+    }
+
+    // Compact newlines out of the content in place
     lineBreaks.clear();
     lineBreaks.push_back(0);
-    // Calculate width based on longest line
-    size_t longestLine = 0;
-    size_t currentLineLength = 0;
+    size_t out = 0;
+    for (size_t in = 0; in < content.size(); ++in) {
+        if (content[in] == U'\n') {
+            lineBreaks.push_back(out);
+        } else {
+            content[out++] = content[in];
+        }
+    }
+    content.resize(out);
 
-    size_t i = 0;
-    while (i < text.size()) {
-        // Decode UTF-8 character, decoded is an std::pair of the size and the
-        // character
-        auto decoded = decodeUTF8Char(text, i);
-        // Ignore newlines in content for cleaner storage; we track line breaks
-        // separately
-        if (decoded.second != '\n') {
-            content.push_back(ColoredChar(decoded.second, color));
-            ++currentLineLength;
+    marqueeOffset = 0;
+    measureWidths();
+    layoutLines();
+    markDirty();
+}
+
+ClipRect Text::contentArea(size_t first, size_t last) const {
+    if (marqueeWidth != 0) {
+        return ALL_CELLS;
+    }
+
+    // Index of the visual line holding a character, empty lines hold nothing
+    // so the last line starting at or before the index is the one
+    auto lineOf = [this](size_t index) {
+        auto after = std::upper_bound(
+            lines.begin(), lines.end(), index,
+            [](size_t value, const Line& line) { return value < line.start; });
+        return static_cast<int32_t>(after - lines.begin()) - 1;
+    };
+
+    int32_t top = std::max(lineOf(first), 0);
+    int32_t bottom = std::max(lineOf(last), 0);
+    if (top != bottom) {
+        return {0, top, static_cast<int32_t>(getWidth()), bottom + 1};
+    }
+    const Line& line = lines[static_cast<size_t>(top)];
+    uint32_t lastWidth = last < content.size() ? displayWidth(content[last]) : 1;
+    return {static_cast<int32_t>(columnOf(line, first)), top,
+            static_cast<int32_t>(columnOf(line, last) + lastWidth), top + 1};
+}
+
+void Text::measureWidths() {
+    // One pass of table reads decides whether cells and characters match
+    narrow = true;
+    for (char32_t c : content) {
+        narrow &= displayWidth(c) == 1;
+    }
+}
+
+void Text::layoutLines() {
+    // clear() keeps the capacity, so relayouts that produce no more lines
+    // than before do not allocate
+    lines.clear();
+    uint32_t limit = overflow == TextOverflow::Clip ? 0 : maxWidth;
+
+    for (size_t paragraph = 0; paragraph < lineBreaks.size(); ++paragraph) {
+        size_t start = lineBreaks[paragraph];
+        size_t length = lineLength(paragraph);
+        Line whole{start, static_cast<uint32_t>(length), 0, false};
+        whole.width = columnOf(whole, start + length);
+        if (paragraph == 0) {
+            marqueeCells = whole.width;
+        }
+
+        if (limit == 0 || whole.width <= limit) {
+            lines.push_back(whole);
+        } else if (overflow == TextOverflow::Ellipsis) {
+            // Keep the characters that fit next to the ellipsis
+            size_t end = start;
+            uint32_t cells = 0;
+            while (cells + displayWidth(content[end]) < limit) {
+                cells += displayWidth(content[end++]);
+            }
+            lines.push_back(
+                {start, static_cast<uint32_t>(end - start), cells + 1, true});
+        } else {
+            wrapParagraph(start, start + length, limit);
+        }
+    }
+
+    if (marqueeWidth != 0) {
+        setWidth(marqueeWidth);
+        setHeight(1);
+        return;
+    }
+
+    uint32_t longestLine = 0;
+    for (const Line& line : lines) {
+        longestLine = std::max(longestLine, line.width);
+    }
+    setHeight(static_cast<uint32_t>(lines.size()));
+    setWidth(longestLine);
+}
+
+void Text::wrapParagraph(size_t start, size_t end, uint32_t limit) {
+    size_t pos = start;
+    while (true) {
+        // Find the first character that does not fit on this line
+        size_t fit = pos;
+        uint32_t cells = 0;
+        if (narrow) {
+            if (end - pos <= limit) {
+                break;
+            }
+            fit = pos + limit;
+            cells = limit;
         } else {
-            if (currentLineLength > longestLine) {
-                longestLine = currentLineLength;
+            while (fit < end && cells + displayWidth(content[fit]) <= limit) {
+                cells += displayWidth(content[fit++]);
+            }
+            if (fit == end) {
+                break;
+            }
+        }
+
+        // Break at the last space that keeps the line within the limit, a
+        // space right after the limit also works since it is dropped
+        size_t breakAt = fit;
+        while (breakAt > pos && content[breakAt] != U' ') {
+            --breakAt;
+        }
+
+        if (breakAt == pos) {
+            // A single word is longer than the line, split it. A wide
+            // character on a one cell line still has to advance.
+            if (fit == pos) {
+                cells = displayWidth(content[fit++]);
+            }
+            lines.push_back({pos, static_cast<uint32_t>(fit - pos), cells,
+                             false});
+            pos = fit;
+            if (pos == end) {
+                return;
             }
-            currentLineLength = 0;
-            lineBreaks.push_back(content.size());
+        } else {
+            Line line{pos, static_cast<uint32_t>(breakAt - pos), 0, false};
+            line.width = columnOf(line, breakAt);
+            lines.push_back(line);
+            pos = breakAt + 1;
         }
+    }
+    Line last{pos, static_cast<uint32_t>(end - pos), 0, false};
+    last.width = columnOf(last, end);
+    lines.push_back(last);
+}
 
-        i += decoded.first;
+void Text::setMaxWidth(uint32_t w, TextOverflow mode) {
+    if (w == maxWidth && mode == overflow) {
+        return;
     }
-    if (currentLineLength > longestLine) {
-        longestLine = currentLineLength;
+    maxWidth = w;
+    overflow = mode;
+    layoutLines();
+    markDirty();
+}
+
+void Text::resize(uint32_t w, uint32_t h) {
+    if (overflow != TextOverflow::Clip) {
+        setMaxWidth(w);
     }
+    Component::resize(w, h);
+}
 
-    setHeight(static_cast<uint32_t>(lineBreaks.size()));
-    setWidth(static_cast<uint32_t>(longestLine));
+void Text::setMarquee(uint32_t visibleWidth, uint32_t gap) {
+    marqueeWidth = visibleWidth;
+    marqueeGap = gap;
+    marqueeOffset = 0;
+    layoutLines();
+    markDirty();
+}
+
+void Text::stopMarquee() {
+    if (marqueeWidth == 0) {
+        return;
+    }
+    marqueeWidth = 0;
+    layoutLines();
+    markDirty();
+}
 
-    paintFG(color, 0, content.size());
+bool Text::advanceMarquee(uint32_t step) {
+    if (marqueeWidth == 0) {
+        return false;
+    }
+    if (marqueeCells <= marqueeWidth) {
+        return false;
+    }
+    marqueeOffset = (marqueeOffset + step) % (marqueeCells + marqueeGap);
+    markDirty();
+    return true;
 }
 
 void Text::rebuildFromString(const std::string& text, uint8_t r, uint8_t g,
@@ -84,4 +588,118 @@ void Text::rebuildFromString(const std::string& text, uint8_t r, uint8_t g,
     rebuildFromString(text, (static_cast<uint32_t>(r) << 24) |
                                 (static_cast<uint32_t>(g) << 16) |
                                 (static_cast<uint32_t>(b) << 8) | 0xFF);
-}
\ No newline at end of file
+}
+void Text::blit(const Surface& surface) const {
+    if (marqueeWidth != 0) {
+        // The window wraps around the text, draw it cell by cell
+        blitPixels(*this, surface);
+        return;
+    }
+
+    int32_t x = static_cast<int32_t>(getX());
+    int32_t y = static_cast<int32_t>(getY());
+    ClipRect r = surface.visibleRect(x, y, getWidth(), getHeight());
+    if (r.empty()) {
+        return;
+    }
+
+    int32_t baseX = surface.getOriginX() + x;
+    int32_t baseY = surface.getOriginY() + y;
+    for (int32_t fy = r.top; fy < r.bottom; ++fy) {
+        ColoredChar* out = surface.row(fy);
+        size_t localY = static_cast<size_t>(fy - baseY);
+        int32_t textEnd = r.left;  // Frame column after the drawn text
+
+        if (localY < lines.size() && !runs.empty()) {
+            const Line& line = lines[localY];
+            int32_t lineEnd =
+                std::min(r.right, baseX + static_cast<int32_t>(line.width));
+            if (r.left < lineEnd) {
+                if (narrow) {
+                    blitNarrow(line, out, r.left - baseX,
+                               std::min(lineEnd - baseX,
+                                        static_cast<int32_t>(line.length)),
+                               baseX);
+                } else {
+                    blitWide(line, out, r.left - baseX, lineEnd - baseX, baseX);
+                }
+
+                int32_t ellipsisX = baseX + static_cast<int32_t>(line.width) - 1;
+                if (line.ellipsis && ellipsisX >= r.left && ellipsisX < lineEnd) {
+                    // Styled like the first character it hides
+                    out[ellipsisX] = cellAt(line.start + line.length);
+                    out[ellipsisX].c = U'…';
+                }
+                textEnd = lineEnd;
+            }
+        }
+
+        std::fill(out + textEnd, out + r.right, BLANK_CHARACTER);
+    }
+}
+
+void Text::blitNarrow(const Line& line, ColoredChar* out, int32_t from,
+                      int32_t to, int32_t baseX) const {
+    if (from >= to) {
+        return;
+    }
+    size_t index = line.start + static_cast<size_t>(from);
+    size_t endIndex = line.start + static_cast<size_t>(to);
+    size_t run = static_cast<size_t>(&runAt(index) - runs.data());
+    ColoredChar* cell = out + baseX + from;
+
+    // Every character of a run shares one style, only the code point changes
+    while (index < endIndex) {
+        const StyleRun& style = runs[run++];
+        size_t spanEnd = std::min(style.end(), endIndex);
+        ColoredChar styled(U' ', style.fg, style.bg, style.attrs);
+        for (; index < spanEnd; ++index) {
+            styled.c = content[index];
+            *cell++ = styled;
+        }
+    }
+}
+
+void Text::blitWide(const Line& line, ColoredChar* out, int32_t from,
+                    int32_t to, int32_t baseX) const {
+    size_t index = line.start;
+    size_t end = line.start + line.length;
+    int32_t column = 0;
+
+    // Skip the characters left of the visible cells
+    while (index < end) {
+        int32_t width = static_cast<int32_t>(displayWidth(content[index]));
+        if (column + width > from) {
+            break;
+        }
+        column += width;
+        ++index;
+    }
+    if (index == end) {
+        return;
+    }
+
+    size_t run = static_cast<size_t>(&runAt(index) - runs.data());
+    for (; index < end && column < to; ++index) {
+        int32_t width = static_cast<int32_t>(displayWidth(content[index]));
+        if (width == 0) {
+            continue;
+        }
+        while (runs[run].end() <= index) {
+            ++run;
+        }
+        const StyleRun& style = runs[run];
+        ColoredChar styled(content[index], style.fg, style.bg, style.attrs);
+
+        // Halves cut off by the clip are still written as they are, the
+        // renderer blanks a half whose partner is missing when it prints
+        if (column >= from) {
+            out[baseX + column] = styled;
+        }
+        if (width == 2 && column + 1 < to) {
+            styled.c = CCHAR_CONTINUATION;
+            out[baseX + column + 1] = styled;
+        }
+        column += width;
+    }
+}
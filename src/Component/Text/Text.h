@@ -8,17 +8,49 @@
  *
  * This class represents a text component that can be added to a Menu. Text is
  * given as a string, and newlines are parsed and width is calculated
- * accordingly. Text is stored as a vector of ColoredChar objects.
+ * accordingly. Text is stored as a vector of code points, with colors and
+ * attributes kept as runs over them.
  */
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
+#include "../../Unicode/DisplayWidth/DisplayWidth.h"
 #include "../Component.h"
 
+/**
+ * @brief How Text handles lines longer than its maximum width.
+ *
+ * Clip: Lines keep their full length, the width grows to fit
+ * Wrap: Lines are broken at spaces, or mid-word if a word does not fit
+ * Ellipsis: Lines are cut and end with an ellipsis
+ */
+enum class TextOverflow { Clip, Wrap, Ellipsis };
+
+/**
+ * @brief Style shared by a span of characters in a Text.
+ */
+struct StyleRun {
+    size_t start = 0;             // Index of the first character
+    size_t length = 0;            // Number of characters
+    uint32_t fg = CCHAR_WHITE;    // Foreground color
+    uint32_t bg = CCHAR_DEFAULT;  // Background color
+    uint8_t attrs = 0;            // CCHAR_* attribute bits
+
+    size_t end() const noexcept { return start + length; }
+
+    bool sameStyle(const StyleRun& other) const noexcept {
+        return fg == other.fg && bg == other.bg && attrs == other.attrs;
+    }
+};
+
 /**
  * @class Text
  *
@@ -26,18 +58,253 @@
  *
  * @details
  * Text is a non-editable UI component that stores decoded characters internally
- * and renders them via the Component interface. Newlines define explicit
- * line breaks; no automatic word wrapping is performed.
+ * and renders them via the Component interface. Colors and attributes are
+ * stored as runs over the code points rather than per character, so painting
+ * costs O(runs) and drawing writes one run at a time. Newlines define explicit
+ * line breaks. With a maximum width set, long lines are wrapped or truncated
+ * with an ellipsis.
+ *
+ * Content is segmented into grapheme clusters as it is built, so an accented
+ * letter written with combining marks, a flag or a ZWJ emoji sequence is one
+ * character. Clusters of several code points are interned in ClusterTable
+ * and stored as a single reference, keeping characters a fixed size, and
+ * segmentations are cached per string by GraphemeCache. Indexes into the
+ * content, such as those taken by the paint functions, count clusters.
+ *
+ * Widths are measured in cells: wide characters take a cell and the
+ * continuation cell after it, and zero width characters take none. Text made
+ * only of single cell characters, the usual case, maps cells to characters
+ * directly.
+ *
+ * The visual lines are cached in a table of (start, length) pairs into the
+ * content, which is rebuilt only when the content, the maximum width or the
+ * overflow mode changes. Rebuilding reuses the table's capacity.
+ *
+ * In marquee mode the first line scrolls through a fixed-width window. The
+ * decoded content is kept as is and only the window offset moves, so each step
+ * costs one blit of the visible cells.
+ *
+ * Text is allocator-aware: when constructed inside a Menu's pool its content
+ * is allocated from the menu's arena.
  */
 class Text : public Component {
+   public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
    private:
-    std::vector<ColoredChar>
-        content;  // Stores colored characters in a flat array.
-    std::vector<size_t> lineBreaks = {
-        0};  // Indexes of the start of each line in content.
+    /**
+     * @brief A line as drawn, a span of content.
+     */
+    struct Line {
+        size_t start = 0;       // Index of the first character in content
+        uint32_t length = 0;    // Number of characters shown
+        uint32_t width = 0;     // Number of cells, including the ellipsis
+        bool ellipsis = false;  // An ellipsis follows the characters
+    };
+
+    std::pmr::vector<char32_t> content;  // Code points and interned clusters
+    std::pmr::vector<StyleRun> runs;     // Styles covering content in order
+    std::pmr::vector<size_t>
+        lineBreaks;  // Indexes of the start of each paragraph in content.
+    std::pmr::vector<Line> lines;  // Cached visual lines
+    TextOverflow overflow = TextOverflow::Clip;
+    uint32_t maxWidth = 0;  // Width lines are fitted to, 0 for unlimited
+    uint32_t marqueeWidth = 0;   // Visible width in marquee mode, 0 when off
+    uint32_t marqueeGap = 0;     // Blank cells before the text repeats
+    uint32_t marqueeOffset = 0;  // Position shown in the leftmost cell
+    uint32_t marqueeCells = 0;   // Width of the scrolling first line
+    bool narrow = true;  // Every character takes one cell, so cells and
+                         // characters map directly
+
+    /**
+     * @brief Returns the number of characters in a paragraph.
+     */
+    size_t lineLength(size_t line) const noexcept {
+        size_t end =
+            line + 1 < lineBreaks.size() ? lineBreaks[line + 1] : content.size();
+        return end - lineBreaks[line];
+    }
+
+    /**
+     * @brief Checks whether every character takes exactly one cell.
+     */
+    void measureWidths();
+
+    /**
+     * @brief Rebuilds the visual line table and the size.
+     */
+    void layoutLines();
+
+    /**
+     * @brief What writeContent() changed.
+     */
+    struct ContentChange {
+        size_t first = SIZE_MAX;     // First changed character
+        size_t last = 0;             // Last changed character
+        bool reshaped = false;       // Length or line breaks changed
+        bool spacesChanged = false;  // Word boundaries moved
+        bool widthsChanged = false;  // A character changed its cell count
+    };
+
+    /**
+     * @brief Writes new code points over the content and line breaks,
+     * reusing their capacity and tracking what changed.
+     *
+     * @param next callable taking a char32_t& that stores the next code point
+     * and returns false at the end
+     */
+    template <typename NextChar>
+    ContentChange writeContent(NextChar&& next);
+
+    /**
+     * @brief Replaces the style runs.
+     *
+     * @return true if the runs differ from the previous ones
+     */
+    bool replaceRuns(const StyleRun* styles, size_t count);
+
+    /**
+     * @brief Relays out and marks dirty whatever a rebuild changed.
+     */
+    void finishRebuild(const ContentChange& change, bool restyled);
+
+    /**
+     * @brief Moves U'\n' characters out of new content into the line breaks
+     * and lays it out.
+     */
+    void adoptContent();
+
+    /**
+     * @brief Splits cells into code points and style runs and rebuilds from
+     * them as rebuildStyled() does.
+     */
+    void rebuildCells(const ColoredChar* cells, size_t count);
+
+    /**
+     * @brief Returns the run styling a character.
+     */
+    const StyleRun& runAt(size_t index) const noexcept {
+        auto after = std::upper_bound(
+            runs.begin(), runs.end(), index,
+            [](size_t value, const StyleRun& run) { return value < run.start; });
+        return *(after - 1);
+    }
+
+    /**
+     * @brief Returns a character with its style.
+     */
+    ColoredChar cellAt(size_t index) const noexcept {
+        const StyleRun& run = runAt(index);
+        return ColoredChar(content[index], run.fg, run.bg, run.attrs);
+    }
+
+    /**
+     * @brief Splits the run containing a character so a run starts there.
+     *
+     * @return size_t index of the run starting at @p index, runs.size() if
+     * @p index is the end of the content
+     */
+    size_t splitRunAt(size_t index);
+
+    /**
+     * @brief Applies a change to the style of a range of characters.
+     *
+     * @param start first character
+     * @param n number of characters, 0 for all up to the end
+     * @param change callable modifying a StyleRun
+     */
+    template <typename Change>
+    void restyle(size_t start, size_t n, Change&& change);
+
+    /**
+     * @brief Returns the cells showing a range of content, in local
+     * coordinates. A scrolling marquee moves its columns, so there it is
+     * the whole Text.
+     *
+     * @param first index of the first character
+     * @param last index of the last character
+     */
+    ClipRect contentArea(size_t first, size_t last) const;
+
+    /**
+     * @brief Returns the cell a character starts at, relative to its line.
+     */
+    uint32_t columnOf(const Line& line, size_t index) const noexcept {
+        if (narrow) {
+            return static_cast<uint32_t>(index - line.start);
+        }
+        return static_cast<uint32_t>(
+            displayWidth(content.data() + line.start, index - line.start));
+    }
+
+    /**
+     * @brief Returns the cell at a column of a span of content, for text
+     * with wide or zero width characters.
+     *
+     * @param start first character of the span
+     * @param end character after the span
+     * @param column cell relative to the start of the span
+     */
+    ColoredChar cellAtColumn(size_t start, size_t end,
+                             uint32_t column) const noexcept {
+        uint32_t cell = 0;
+        for (size_t index = start; index < end; ++index) {
+            uint32_t width = displayWidth(content[index]);
+            if (column < cell + width) {
+                ColoredChar found = cellAt(index);
+                if (column != cell) {
+                    found.c = CCHAR_CONTINUATION;
+                }
+                return found;
+            }
+            cell += width;
+        }
+        return BLANK_CHARACTER;
+    }
+
+    /**
+     * @brief Appends the visual lines of a wrapped paragraph.
+     */
+    void wrapParagraph(size_t start, size_t end, uint32_t limit);
+
+    /**
+     * @brief Draws the visible part of a line of single cell characters.
+     *
+     * @param line line to draw
+     * @param out frame row
+     * @param from first cell to draw, relative to the line
+     * @param to cell after the last character to draw
+     * @param baseX frame column of the start of the line
+     */
+    void blitNarrow(const Line& line, ColoredChar* out, int32_t from,
+                    int32_t to, int32_t baseX) const;
+
+    /**
+     * @brief Draws the visible part of a line with wide or zero width
+     * characters, writing a continuation cell after each wide character.
+     *
+     * @param line line to draw
+     * @param out frame row
+     * @param from first cell to draw, relative to the line
+     * @param to cell after the last cell to draw
+     * @param baseX frame column of the start of the line
+     */
+    void blitWide(const Line& line, ColoredChar* out, int32_t from,
+                  int32_t to, int32_t baseX) const;
 
    public:
-    Text() = default;
+    Text() : Text(std::allocator_arg, allocator_type()) {}
+
+    /**
+     * @brief Construct an empty Text object using the given allocator.
+     *
+     * @param alloc allocator for the text content
+     */
+    Text(std::allocator_arg_t, const allocator_type& alloc)
+        : content(alloc),
+          runs(alloc),
+          lineBreaks(1, 0, alloc),
+          lines(1, Line{}, alloc) {}
 
     /**
      * @brief Construct a new Text object.
@@ -51,7 +318,24 @@ class Text : public Component {
      */
     explicit Text(int32_t xCoord, int32_t yCoord,
                   const std::string& textContent, uint8_t r, uint8_t g,
-                  uint8_t b);
+                  uint8_t b)
+        : Text(std::allocator_arg, allocator_type(), xCoord, yCoord,
+               textContent, r, g, b){};
+
+    /**
+     * @brief Construct a new Text object using the given allocator.
+     *
+     * @param alloc allocator for the text content
+     * @param xCoord x coordinate
+     * @param yCoord y coordinate
+     * @param textContent text string
+     * @param r red color component (0-255)
+     * @param g green color component (0-255)
+     * @param b blue color component (0-255)
+     */
+    Text(std::allocator_arg_t, const allocator_type& alloc, int32_t xCoord,
+         int32_t yCoord, const std::string& textContent, uint8_t r, uint8_t g,
+         uint8_t b);
     /**
      * @brief Construct a new Text object with the color as one uint32_t.
      *
@@ -65,6 +349,21 @@ class Text : public Component {
         : Text(xCoord, yCoord, textContent, (rgba >> 24) & 0xFF,
                (rgba >> 16) & 0xFF, (rgba >> 8) & 0xFF){};
 
+    /**
+     * @brief Construct a new Text object with the color as one uint32_t using
+     * the given allocator.
+     *
+     * @param alloc allocator for the text content
+     * @param xCoord x coordinate
+     * @param yCoord y coordinate
+     * @param textContent text string
+     * @param rgba 32-bit RGBA color as uint32_t
+     */
+    Text(std::allocator_arg_t, const allocator_type& alloc, int32_t xCoord,
+         int32_t yCoord, const std::string& textContent, uint32_t rgba)
+        : Text(std::allocator_arg, alloc, xCoord, yCoord, textContent,
+               (rgba >> 24) & 0xFF, (rgba >> 16) & 0xFF, (rgba >> 8) & 0xFF){};
+
     Text(const Text& other) = default;
     Text& operator=(const Text& other) = default;
     Text(Text&& other) noexcept = default;
@@ -72,11 +371,26 @@ class Text : public Component {
 
     ~Text() = default;
 
+    /**
+     * @brief Get the allocator used for the text content
+     *
+     * @return allocator_type
+     */
+    allocator_type get_allocator() const noexcept {
+        return content.get_allocator();
+    }
+
     /**
      * @brief Change the text inside the Text object
      *
      * @param text text to change to
      * @param color color of text (default is CCHAR_WHITE)
+     *
+     * @details
+     * The text is decoded over the existing content, reusing its capacity.
+     * Unchanged text is detected and does not mark the component dirty. If
+     * the text keeps its shape, as a clock does when a digit changes, only the
+     * cells that changed are marked dirty.
      */
     void rebuildFromString(const std::string& text, uint32_t color = CCHAR_WHITE);
 
@@ -93,9 +407,146 @@ class Text : public Component {
     /**
      * @brief Change the text inside the Text object
      *
-     * @param text vector of ColoredChar text to change to
+     * @param text vector of ColoredChar text to change to, U'\n' characters
+     * start new lines. Neighbouring characters with the same style share a
+     * run.
+     *
+     * @details
+     * Code points are segmented into grapheme clusters, each taking the style
+     * of its first code point. Like the string overloads, unchanged text does
+     * not mark the component dirty and a rebuild that keeps the shape and
+     * styles only marks the changed cells.
+     */
+    void rebuildFromString(const std::vector<ColoredChar>& text);
+
+    /**
+     * @brief Change the text inside the Text object from a prebuilt buffer
+     * of ColoredChar
+     *
+     * @param text characters to take, U'\n' characters start new lines. The
+     * buffer is left empty.
+     *
+     * @details
+     * Styles are stored as runs over the code points, so the cells are
+     * converted as by the const reference overload rather than moved in. To
+     * move a buffer in without copying, build code points and use the
+     * std::pmr::vector<char32_t> overload.
+     */
+    void rebuildFromString(std::pmr::vector<ColoredChar>&& text);
+
+    /**
+     * @brief Change the text inside the Text object, taking over a prebuilt
+     * buffer of code points
+     *
+     * @param text code points to move in, U'\n' characters start new lines
+     * @param color color of text (default is CCHAR_WHITE)
+     *
+     * @details
+     * The buffer is taken without copying if it uses the same memory resource
+     * as the text, e.g. one obtained from get_allocator().
+     */
+    void rebuildFromString(std::pmr::vector<char32_t>&& text,
+                           uint32_t color = CCHAR_WHITE);
+
+    /**
+     * @brief Change the text and its styles
+     *
+     * @param text code points, U'\n' characters start new lines
+     * @param styles runs covering the code points of the text without its
+     * newlines, in order
+     *
+     * @details
+     * Like rebuildFromString(), capacity is reused and only the cells that
+     * changed are marked dirty when the shape and styles stay the same. Runs
+     * that do not cover the text are replaced by the default style. Runs are
+     * moved onto the grapheme clusters, each taking the style of its first
+     * code point.
+     */
+    void rebuildStyled(const std::u32string& text,
+                       const std::vector<StyleRun>& styles);
+
+    /**
+     * @brief Change the text to styled markup
+     *
+     * @param markup text with style tags, see MarkupTemplate
+     *
+     * @details
+     * The markup is parsed on every call. For lines that are updated often,
+     * keep a MarkupTemplate and only change its values.
+     */
+    void setMarkup(const std::string& markup);
+
+    /**
+     * @brief Get the style runs covering the text, in order
+     *
+     * @return const std::pmr::vector<StyleRun>&
+     */
+    const std::pmr::vector<StyleRun>& getStyleRuns() const noexcept {
+        return runs;
+    }
+
+    /**
+     * @brief Limit the width of the text.
+     *
+     * @param w maximum width in cells, 0 removes the limit
+     * @param mode how longer lines are handled
+     *
+     * @details
+     * Lines are only recomputed if the width or mode actually changed.
+     */
+    void setMaxWidth(uint32_t w, TextOverflow mode);
+
+    /**
+     * @brief Limit the width of the text, keeping the current overflow mode.
+     *
+     * @param w maximum width in cells, 0 removes the limit
+     */
+    void setMaxWidth(uint32_t w) { setMaxWidth(w, overflow); }
+
+    uint32_t getMaxWidth() const noexcept { return maxWidth; }
+    TextOverflow getOverflow() const noexcept { return overflow; }
+
+    /**
+     * @brief Number of lines after wrapping.
+     */
+    size_t getLineCount() const noexcept { return lines.size(); }
+
+    /**
+     * @brief Resizes the text, rewrapping it to the new width unless
+     * overflow is TextOverflow::Clip.
+     *
+     * @param w new width
+     * @param h new height
+     */
+    virtual void resize(uint32_t w, uint32_t h) override;
+
+    /**
+     * @brief Scroll the first line through a window of fixed width.
+     *
+     * @param visibleWidth width of the window, becomes the component width
+     * @param gap blank cells shown between the end of the text and its start
+     *
+     * @details
+     * Call advanceMarquee() from a timer to move the text. Text that fits in
+     * the window does not scroll.
      */
-    void rebuildFromString(std::vector<ColoredChar> text) { content = text; }
+    void setMarquee(uint32_t visibleWidth, uint32_t gap = 3);
+
+    /**
+     * @brief Leave marquee mode and show the whole text again.
+     */
+    void stopMarquee();
+
+    bool isMarquee() const noexcept { return marqueeWidth != 0; }
+
+    /**
+     * @brief Moves the marquee window.
+     *
+     * @param step number of cells to scroll left
+     * @return true if the text moved and the component was marked dirty
+     * @return false if not in marquee mode or the text fits the window
+     */
+    bool advanceMarquee(uint32_t step = 1);
 
     /**
      * @brief Paints a portion of the text with a new color.
@@ -103,18 +554,32 @@ class Text : public Component {
      * @param color New color as uint32_t RGBA
      * @param start Starting index in content vector
      * @param n Number of characters to paint; if 0, paints to end
+     *
+     * @details
+     * Splits at most two runs and merges neighbours that end up with the same
+     * style, so the cost depends on the number of runs, not characters.
      */
     void paintFG(uint32_t color, size_t start = 0, size_t n = 0);
 
     /**
      * @brief Paints a portion of the text background with a new color.
      *
-     * @param color New color as uint32_t RGBA
+     * @param color New color as uint32_t RGBA, CCHAR_DEFAULT for the
+     * terminal's background
      * @param start Starting index in content vector
      * @param n Number of characters to paint; if 0, paints to end
      */
     void paintBG(uint32_t color, size_t start = 0, size_t n = 0);
 
+    /**
+     * @brief Sets the attributes of a portion of the text.
+     *
+     * @param attributes CCHAR_* attribute bits, replacing the current ones
+     * @param start Starting index in content vector
+     * @param n Number of characters to paint; if 0, paints to end
+     */
+    void paintAttributes(uint8_t attributes, size_t start = 0, size_t n = 0);
+
     /**
      * @brief Override for the pixelAt function of the Component class.
      *
@@ -133,18 +598,50 @@ class Text : public Component {
             return BLANK_CHARACTER;
         }
 
-        // Translate (x, y) to index to content vector
-        size_t index;
-        if (lineBreaks.empty()) {
-            index = static_cast<size_t>(x);
+        // Translate (x, y) to a span of content and a cell within it
+        size_t start;
+        size_t end;
+        uint32_t column = static_cast<uint32_t>(x);
+        if (marqueeWidth != 0) {
+            start = 0;
+            end = lineLength(0);
+            if (marqueeCells > marqueeWidth) {
+                column = (column + marqueeOffset) % (marqueeCells + marqueeGap);
+                if (column >= marqueeCells) {
+                    return BLANK_CHARACTER;
+                }
+            }
         } else {
-            index = static_cast<size_t>(x) + lineBreaks[static_cast<size_t>(y)];
+            if (static_cast<size_t>(y) >= lines.size()) {
+                return BLANK_CHARACTER;
+            }
+            const Line& line = lines[static_cast<size_t>(y)];
+            if (column >= line.width) {
+                return BLANK_CHARACTER;
+            }
+            start = line.start;
+            end = line.start + line.length;
+            if (line.ellipsis && column + 1 == line.width) {
+                // Styled like the first character it hides
+                ColoredChar ellipsis = cellAt(end);
+                ellipsis.c = U'…';
+                return ellipsis;
+            }
         }
 
-        if (index >= content.size()) {
+        if (!narrow) {
+            return cellAtColumn(start, end, column);
+        }
+        if (start + column >= end) {
             return BLANK_CHARACTER;
         }
-
-        return content[index];
+        return cellAt(start + column);
     }
+
+    /**
+     * @brief Draws the component into a surface one style run at a time.
+     *
+     * @param surface surface to draw into
+     */
+    virtual void blit(const Surface& surface) const override final;
 };
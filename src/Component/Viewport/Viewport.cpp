@@ -0,0 +1,70 @@
+/**
+ * @file Viewport.cpp
+ * @author Amin Karic
+ * @brief Viewport container component implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for Viewport class.
+ */
+
+#include "Viewport.h"
+
+#include <algorithm>
+#include <variant>
+
+#include "../AlbumAsciiArt/AlbumAsciiArt.h"
+#include "../ListView/ListView.h"
+#include "../SeekBar/SeekBar.h"
+#include "../Text/Text.h"
+
+bool Viewport::removeChild(const Component* child) {
+    auto found = std::find_if(
+        children.begin(), children.end(),
+        [child](const ComponentRef& ref) { return toComponent(ref) == child; });
+    if (found == children.end()) {
+        return false;
+    }
+    children.erase(found);
+    markDirty();
+    return true;
+}
+
+ColoredChar Viewport::pixelAt(int32_t x, int32_t y) const noexcept {
+    if (x < 0 || y < 0 || x >= static_cast<int>(getWidth()) ||
+        y >= static_cast<int>(getHeight())) {
+        return BLANK_CHARACTER;
+    }
+
+    int32_t contentX = x + scrollX;
+    int32_t contentY = y + scrollY;
+    for (auto i = children.rbegin(); i != children.rend(); ++i) {
+        const Component* c = toComponent(*i);
+        int32_t localX = contentX - static_cast<int32_t>(c->getX());
+        int32_t localY = contentY - static_cast<int32_t>(c->getY());
+        if (localX >= 0 && localY >= 0 &&
+            localX < static_cast<int32_t>(c->getWidth()) &&
+            localY < static_cast<int32_t>(c->getHeight())) {
+            return c->pixelAt(localX, localY);
+        }
+    }
+    return BLANK_CHARACTER;
+}
+
+void Viewport::blit(const Surface& surface) const {
+    int32_t x = static_cast<int32_t>(getX());
+    int32_t y = static_cast<int32_t>(getY());
+    Surface inner =
+        surface.child(x, y, getWidth(), getHeight(), scrollX, scrollY);
+    if (inner.getClip().empty()) {
+        return;
+    }
+
+    // Clear the area so scrolled content never shows what is underneath
+    inner.fill(inner.getClip(), BLANK_CHARACTER);
+
+    for (const auto& ref : children) {
+        std::visit([&inner](const auto* c) { c->blit(inner); }, ref);
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file Viewport.h
+ * @author Amin Karic
+ * @brief Viewport container component definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * This class is a container that clips its children to its own rectangle and
+ * shifts them by a scroll offset. Children are positioned relative to the
+ * viewport's content origin and are owned by the Menu the viewport belongs to.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../../ColoredChar/ColoredChar.h"
+#include "../Component.h"
+#include "../ComponentRef.h"
+
+/**
+ * @class Viewport
+ *
+ * @brief Clipping, scrollable container of components.
+ *
+ * @details
+ * When drawn, the viewport clears its area and draws its children into a
+ * surface whose clip rectangle is the intersection of the parent's clip and
+ * the viewport's rectangle. Nested viewports keep intersecting, so every child
+ * is clipped once per container and then written without per-cell checks.
+ */
+class Viewport : public Component {
+   private:
+    std::vector<ComponentRef> children;  // Children in draw order, not owned
+    int32_t scrollX = 0;                 // Content x shown at the left edge
+    int32_t scrollY = 0;                 // Content y shown at the top edge
+
+   public:
+    Viewport() = default;
+
+    /**
+     * @brief Construct a new Viewport object
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param w width
+     * @param h height
+     */
+    explicit Viewport(int32_t x, int32_t y, uint32_t w, uint32_t h)
+        : Component(x, y, w, h){};
+
+    Viewport(const Viewport& other) = default;
+    Viewport& operator=(const Viewport& other) = default;
+    Viewport(Viewport&& other) noexcept = default;
+    Viewport& operator=(Viewport&& other) noexcept = default;
+
+    ~Viewport() = default;
+
+    /**
+     * @brief Adds a child on top of the existing children.
+     *
+     * @param child component to add, must outlive its membership
+     *
+     * @details
+     * Use Menu::emplaceComponentIn() or Menu::addComponent() with a parent so
+     * the menu owns the child.
+     */
+    void addChild(ComponentRef child) {
+        children.push_back(child);
+        markDirty();
+    }
+
+    /**
+     * @brief Removes a child without deleting it.
+     *
+     * @param child component to remove
+     * @return true the child was found and removed
+     * @return false the component is not a child of this viewport
+     */
+    bool removeChild(const Component* child);
+
+    const std::vector<ComponentRef>& getChildren() const noexcept {
+        return children;
+    }
+
+    /**
+     * @brief Sets the content coordinate shown at the top-left corner.
+     *
+     * @param x horizontal scroll offset
+     * @param y vertical scroll offset
+     */
+    void setScroll(int32_t x, int32_t y) {
+        if (x == scrollX && y == scrollY) {
+            return;
+        }
+        scrollX = x;
+        scrollY = y;
+        markDirty();
+    }
+
+    /**
+     * @brief Moves the scroll offset.
+     *
+     * @param dx horizontal change
+     * @param dy vertical change
+     */
+    void scrollBy(int32_t dx, int32_t dy) {
+        setScroll(scrollX + dx, scrollY + dy);
+    }
+
+    int32_t getScrollX() const noexcept { return scrollX; }
+    int32_t getScrollY() const noexcept { return scrollY; }
+
+    /**
+     * @brief Return the ColoredChar at given pixel coordinates
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @return ColoredChar of the topmost child covering (x, y),
+     * BLANK_CHARACTER if out of bounds or not covered
+     *
+     * @details
+     * This is only used when the viewport is drawn cell by cell; blit() draws
+     * the children directly.
+     */
+    virtual ColoredChar pixelAt(int32_t x,
+                                int32_t y) const noexcept override final;
+
+    /**
+     * @brief Draws the viewport and its children into a surface.
+     *
+     * @param surface surface to draw into
+     */
+    virtual void blit(const Surface& surface) const override final;
+};
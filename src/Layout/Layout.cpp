@@ -0,0 +1,232 @@
+/**
+ * @file Layout.cpp
+ * @author Amin Karic
+ * @brief Stack layout engine implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Layout.h"
+
+#include <algorithm>
+
+void LayoutNode::markArrangeDirty() {
+    dirty = true;
+    // Stop early since a marked node's ancestors are already marked
+    for (LayoutNode* p = parent; p != nullptr && !p->childDirty;
+         p = p->parent) {
+        p->childDirty = true;
+    }
+}
+
+void LayoutNode::markDirty() {
+    // A node's size is decided by its parent's arrangement
+    if (parent != nullptr) {
+        parent->markArrangeDirty();
+    } else {
+        markArrangeDirty();
+    }
+}
+
+void LayoutNode::setWidth(SizeSpec spec) {
+    if (spec != widthSpec) {
+        widthSpec = spec;
+        markDirty();
+    }
+}
+
+void LayoutNode::setHeight(SizeSpec spec) {
+    if (spec != heightSpec) {
+        heightSpec = spec;
+        markDirty();
+    }
+}
+
+void LayoutNode::setDirection(Direction dir) {
+    if (dir != direction) {
+        direction = dir;
+        markArrangeDirty();
+    }
+}
+
+void LayoutNode::setPadding(Padding pad) {
+    if (pad != padding) {
+        padding = pad;
+        markArrangeDirty();
+    }
+}
+
+void LayoutNode::setSpacing(uint32_t cells) {
+    if (cells != spacing) {
+        spacing = cells;
+        markArrangeDirty();
+    }
+}
+
+uint32_t LayoutNode::measure(const SizeSpec& spec, uint32_t available,
+                             bool horizontal) const {
+    switch (spec.mode) {
+        case SizeMode::Fixed:
+            return spec.value;
+        case SizeMode::Percent:
+            return static_cast<uint32_t>(static_cast<uint64_t>(available) *
+                                         spec.value / 100);
+        case SizeMode::Content:
+            if (component == nullptr) {
+                return 0;
+            }
+            return horizontal ? component->getWidth()
+                              : component->getHeight();
+        case SizeMode::Flex:
+        default:
+            return available;
+    }
+}
+
+Layout::Layout(std::pmr::memory_resource* resource) : nodes(resource) {
+    root = createNode(nullptr);
+}
+
+LayoutNode* Layout::createNode(LayoutNode* parent) {
+    LayoutNode* node = &nodes.emplace_back();
+    node->parent = parent;
+    if (parent != nullptr) {
+        parent->children.push_back(node);
+        parent->markArrangeDirty();
+    }
+    return node;
+}
+
+LayoutNode* Layout::addStack(LayoutNode* parent, Direction dir, SizeSpec w,
+                             SizeSpec h) {
+    LayoutNode* node = createNode(parent);
+    node->direction = dir;
+    node->widthSpec = w;
+    node->heightSpec = h;
+    return node;
+}
+
+LayoutNode* Layout::addComponent(LayoutNode* parent, Component* comp,
+                                 SizeSpec w, SizeSpec h, bool resize) {
+    LayoutNode* node = addStack(parent, Direction::Vertical, w, h);
+    node->component = comp;
+    node->resizeComponent = resize;
+    return node;
+}
+
+bool Layout::update(const LayoutRect& bounds) {
+    visited = 0;
+    if (bounds == root->rect && !root->dirty && !root->childDirty) {
+        return false;
+    }
+    place(root, bounds);
+    return visited > 0;
+}
+
+void Layout::place(LayoutNode* node, const LayoutRect& r) {
+    bool moved = r != node->rect;
+    if (!moved && !node->dirty && !node->childDirty) {
+        return;
+    }
+    ++visited;
+
+    if (moved) {
+        node->rect = r;
+        if (node->component != nullptr) {
+            node->component->setX(r.x);
+            node->component->setY(r.y);
+            if (node->resizeComponent) {
+                node->component->resize(r.width, r.height);
+            }
+            node->component->markDirty();
+        }
+    }
+
+    if (moved || node->dirty) {
+        arrange(node);
+    } else {
+        // Only some descendants changed, their cached rectangles still hold
+        for (LayoutNode* child : node->children) {
+            place(child, child->rect);
+        }
+    }
+
+    node->dirty = false;
+    node->childDirty = false;
+}
+
+void Layout::arrange(LayoutNode* node) {
+    if (node->children.empty()) {
+        return;
+    }
+
+    const Padding& pad = node->padding;
+    const LayoutRect& r = node->rect;
+    bool horizontal = node->direction == Direction::Horizontal;
+
+    uint32_t innerW = r.width > pad.left + pad.right
+                          ? r.width - pad.left - pad.right
+                          : 0;
+    uint32_t innerH = r.height > pad.top + pad.bottom
+                          ? r.height - pad.top - pad.bottom
+                          : 0;
+    uint32_t mainSize = horizontal ? innerW : innerH;
+    uint32_t crossSize = horizontal ? innerH : innerW;
+
+    // First pass: sum the sizes that do not depend on the remaining space
+    uint64_t used = static_cast<uint64_t>(node->spacing) *
+                    (node->children.size() - 1);
+    uint64_t flexWeight = 0;
+    for (const LayoutNode* child : node->children) {
+        const SizeSpec& spec = horizontal ? child->widthSpec : child->heightSpec;
+        if (spec.mode == SizeMode::Flex) {
+            flexWeight += spec.value;
+        } else {
+            used += child->measure(spec, mainSize, horizontal);
+        }
+    }
+    uint64_t remaining = used < mainSize ? mainSize - used : 0;
+
+    // Second pass: hand out the remaining space to flex children and place
+    // children one after another
+    int32_t cursor = horizontal ? r.x + static_cast<int32_t>(pad.left)
+                                : r.y + static_cast<int32_t>(pad.top);
+    uint64_t flexLeft = remaining;
+    uint64_t weightLeft = flexWeight;
+    for (LayoutNode* child : node->children) {
+        const SizeSpec& mainSpec =
+            horizontal ? child->widthSpec : child->heightSpec;
+        const SizeSpec& crossSpec =
+            horizontal ? child->heightSpec : child->widthSpec;
+
+        uint32_t mainLen;
+        if (mainSpec.mode == SizeMode::Flex) {
+            // The last flex child takes the rounding remainder
+            mainLen = weightLeft == 0
+                          ? 0
+                          : static_cast<uint32_t>(flexLeft * mainSpec.value /
+                                                  weightLeft);
+            flexLeft -= mainLen;
+            weightLeft -= mainSpec.value;
+        } else {
+            mainLen = child->measure(mainSpec, mainSize, horizontal);
+        }
+        uint32_t crossLen =
+            std::min(child->measure(crossSpec, crossSize, !horizontal),
+                     crossSize);
+
+        LayoutRect childRect;
+        if (horizontal) {
+            childRect = {cursor, r.y + static_cast<int32_t>(pad.top), mainLen,
+                         crossLen};
+        } else {
+            childRect = {r.x + static_cast<int32_t>(pad.left), cursor,
+                         crossLen, mainLen};
+        }
+        place(child, childRect);
+
+        cursor += static_cast<int32_t>(mainLen + node->spacing);
+    }
+}
@@ -0,0 +1,310 @@
+/**
+ * @file Layout.h
+ * @author Amin Karic
+ * @brief Stack layout engine definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A Layout is a tree of nodes that positions components inside a rectangle.
+ * Container nodes stack their children horizontally or vertically, and every
+ * node sizes itself along each axis with a fixed, percentage, flex or content
+ * size. Computed rectangles are cached per node; changing a constraint only
+ * marks the nodes it affects, and update() revisits just those nodes and the
+ * subtrees whose rectangles actually changed.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "../Component/Component.h"
+
+/**
+ * @brief Axis along which a container node stacks its children.
+ */
+enum class Direction { Horizontal, Vertical };
+
+/**
+ * @brief How a node's size along one axis is computed.
+ *
+ * Fixed: value cells
+ * Percent: value percent of the parent's inner size
+ * Flex: share of the space left after fixed, percent and content siblings,
+ * weighted by value. Along the cross axis a flex node fills the parent.
+ * Content: the current size of the bound component (zero without one)
+ */
+enum class SizeMode { Fixed, Percent, Flex, Content };
+
+/**
+ * @brief Size constraint for one axis of a layout node.
+ */
+struct SizeSpec {
+    SizeMode mode = SizeMode::Flex;
+    uint32_t value = 1;
+
+    static constexpr SizeSpec fixed(uint32_t cells) {
+        return {SizeMode::Fixed, cells};
+    }
+    static constexpr SizeSpec percent(uint32_t pct) {
+        return {SizeMode::Percent, pct};
+    }
+    static constexpr SizeSpec flex(uint32_t weight = 1) {
+        return {SizeMode::Flex, weight};
+    }
+    static constexpr SizeSpec content() { return {SizeMode::Content, 0}; }
+
+    bool operator==(const SizeSpec& other) const noexcept {
+        return mode == other.mode && value == other.value;
+    }
+    bool operator!=(const SizeSpec& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Space between a container's edges and its children.
+ */
+struct Padding {
+    uint32_t left = 0;
+    uint32_t top = 0;
+    uint32_t right = 0;
+    uint32_t bottom = 0;
+
+    static constexpr Padding uniform(uint32_t cells) {
+        return {cells, cells, cells, cells};
+    }
+
+    bool operator==(const Padding& other) const noexcept {
+        return left == other.left && top == other.top &&
+               right == other.right && bottom == other.bottom;
+    }
+    bool operator!=(const Padding& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Rectangle in menu coordinates computed for a layout node.
+ */
+struct LayoutRect {
+    int32_t x = 0;
+    int32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    bool operator==(const LayoutRect& other) const noexcept {
+        return x == other.x && y == other.y && width == other.width &&
+               height == other.height;
+    }
+    bool operator!=(const LayoutRect& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+class Layout;
+
+/**
+ * @class LayoutNode
+ *
+ * @brief A container or component slot in a Layout tree.
+ *
+ * @details
+ * Nodes are created and owned by a Layout. Setters only record the change and
+ * mark the affected part of the tree; positions are recomputed on the next
+ * Layout::update().
+ */
+class LayoutNode {
+    friend class Layout;
+
+   public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+   private:
+    LayoutNode* parent = nullptr;
+    std::pmr::vector<LayoutNode*> children;
+    Component* component = nullptr;  // Component positioned by this node
+    bool resizeComponent = false;    // Whether the component is also resized
+
+    Direction direction = Direction::Vertical;
+    SizeSpec widthSpec;
+    SizeSpec heightSpec;
+    Padding padding;
+    uint32_t spacing = 0;  // Cells between consecutive children
+
+    LayoutRect rect;          // Cached result of the last update
+    bool dirty = true;        // Children must be rearranged
+    bool childDirty = false;  // Some descendant must be rearranged
+
+    /**
+     * @brief Marks this node's children for rearrangement.
+     */
+    void markArrangeDirty();
+
+    /**
+     * @brief Returns the size the node asks for along one axis given the
+     * available size of its parent.
+     */
+    uint32_t measure(const SizeSpec& spec, uint32_t available,
+                     bool horizontal) const;
+
+   public:
+    explicit LayoutNode(std::allocator_arg_t, const allocator_type& alloc)
+        : children(alloc) {}
+
+    // Nodes are linked by pointer, so they never move
+    LayoutNode(const LayoutNode& other) = delete;
+    LayoutNode& operator=(LayoutNode const& other) = delete;
+    LayoutNode(LayoutNode&& other) noexcept = delete;
+    LayoutNode& operator=(LayoutNode&& other) noexcept = delete;
+
+    ~LayoutNode() = default;
+
+    /**
+     * @brief Sets the size constraint along the x axis.
+     */
+    void setWidth(SizeSpec spec);
+
+    /**
+     * @brief Sets the size constraint along the y axis.
+     */
+    void setHeight(SizeSpec spec);
+
+    /**
+     * @brief Sets the axis along which children are stacked.
+     */
+    void setDirection(Direction dir);
+
+    /**
+     * @brief Sets the padding between the node's edges and its children.
+     */
+    void setPadding(Padding pad);
+
+    /**
+     * @brief Sets the number of cells between consecutive children.
+     */
+    void setSpacing(uint32_t cells);
+
+    /**
+     * @brief Marks the node as changed so its parent rearranges it.
+     *
+     * @details
+     * Call this when the bound component's content size changes and the node
+     * uses SizeMode::Content.
+     */
+    void markDirty();
+
+    const LayoutRect& getRect() const noexcept { return rect; }
+    Component* getComponent() const noexcept { return component; }
+    LayoutNode* getParent() const noexcept { return parent; }
+};
+
+/**
+ * @class Layout
+ *
+ * @brief Owns a tree of layout nodes and applies it to components.
+ */
+class Layout {
+   private:
+    std::pmr::deque<LayoutNode> nodes;  // Node storage, never reallocates
+    LayoutNode* root;
+    size_t visited = 0;  // Nodes recomputed by the last update()
+
+    LayoutNode* createNode(LayoutNode* parent);
+
+    /**
+     * @brief Assigns a rectangle to a node and recomputes what changed below
+     * it.
+     */
+    void place(LayoutNode* node, const LayoutRect& r);
+
+    /**
+     * @brief Computes the rectangles of a node's children.
+     */
+    void arrange(LayoutNode* node);
+
+   public:
+    /**
+     * @brief Construct a new Layout object
+     *
+     * @param resource memory resource the nodes are allocated from
+     */
+    explicit Layout(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Nodes point into the layout's storage, so it cannot be copied or moved
+    Layout(const Layout& other) = delete;
+    Layout& operator=(Layout const& other) = delete;
+    Layout(Layout&& other) noexcept = delete;
+    Layout& operator=(Layout&& other) noexcept = delete;
+
+    ~Layout() = default;
+
+    /**
+     * @brief Get the root node, a vertical container filling the bounds
+     * passed to update().
+     */
+    LayoutNode* getRoot() noexcept { return root; }
+
+    /**
+     * @brief Adds a container node.
+     *
+     * @param parent node to add to
+     * @param dir axis the new node stacks its children along
+     * @param w width constraint
+     * @param h height constraint
+     * @return LayoutNode* the new node
+     */
+    LayoutNode* addStack(LayoutNode* parent, Direction dir,
+                         SizeSpec w = SizeSpec::flex(),
+                         SizeSpec h = SizeSpec::flex());
+
+    /**
+     * @brief Adds a node that positions a component.
+     *
+     * @param parent node to add to
+     * @param comp component to position, not owned
+     * @param w width constraint
+     * @param h height constraint
+     * @param resize whether the component is resized to the node's rectangle
+     * @return LayoutNode* the new node
+     */
+    LayoutNode* addComponent(LayoutNode* parent, Component* comp,
+                             SizeSpec w = SizeSpec::content(),
+                             SizeSpec h = SizeSpec::content(),
+                             bool resize = false);
+
+    /**
+     * @brief Adds an empty node that only takes up space.
+     *
+     * @param parent node to add to
+     * @param w width constraint
+     * @param h height constraint
+     * @return LayoutNode* the new node
+     */
+    LayoutNode* addSpacer(LayoutNode* parent, SizeSpec w, SizeSpec h) {
+        return addStack(parent, Direction::Vertical, w, h);
+    }
+
+    /**
+     * @brief Recomputes the nodes affected by changes since the last update.
+     *
+     * @param bounds rectangle the root node fills
+     * @return true if any node was recomputed
+     *
+     * @details
+     * When nothing changed this returns immediately. Otherwise only dirty
+     * nodes and nodes whose rectangle changed are visited.
+     */
+    bool update(const LayoutRect& bounds);
+
+    /**
+     * @brief Get the number of nodes recomputed by the last update()
+     */
+    size_t getLastVisitCount() const noexcept { return visited; }
+};
@@ -0,0 +1,147 @@
+/**
+ * @file ComponentPool.h
+ * @author Amin Karic
+ * @brief Pool storing components of a single concrete type.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * ComponentPool keeps components of one concrete type in chunked contiguous
+ * storage instead of one heap allocation per component. Elements never move
+ * once created, so the pointer returned by emplace() is a stable handle for
+ * the lifetime of the element. Erased slots are reset and reused by later
+ * emplace() calls.
+ *
+ * Storage is drawn from a polymorphic memory resource. Components that are
+ * allocator-aware (they declare an allocator_type) also receive the resource
+ * for their own content when they are constructed in the pool.
+ */
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ComponentPool
+ *
+ * @brief Slot-reusing storage for components of type T.
+ *
+ * @tparam T concrete component type, must be default constructible
+ */
+template <typename T>
+class ComponentPool {
+   private:
+    using Alloc = std::pmr::polymorphic_allocator<T>;
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    std::pmr::deque<T> slots;           // Component storage, never reallocates
+    std::pmr::vector<bool> live;        // Whether each slot holds a component
+    std::pmr::vector<size_t> freeSlots; // Indexes of erased slots to reuse
+
+    /**
+     * @brief Destroys the component in a slot and constructs a new one in
+     * place with the pool's allocator.
+     */
+    template <typename... Args>
+    void reconstruct(size_t index, Args&&... args) {
+        Alloc alloc = slots.get_allocator();
+        T* slot = &slots[index];
+        AllocTraits::destroy(alloc, slot);
+        try {
+            AllocTraits::construct(alloc, slot, std::forward<Args>(args)...);
+        } catch (...) {
+            // Keep the slot holding a valid object so it can be destroyed later
+            AllocTraits::construct(alloc, slot);
+            throw;
+        }
+    }
+
+   public:
+    explicit ComponentPool(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : slots(resource), live(resource), freeSlots(resource) {}
+
+    ComponentPool(const ComponentPool& other) = delete;
+    ComponentPool& operator=(ComponentPool const& other) = delete;
+    ComponentPool(ComponentPool&& other) noexcept = default;
+    ComponentPool& operator=(ComponentPool&& other) noexcept = default;
+
+    ~ComponentPool() = default;
+
+    /**
+     * @brief Constructs a component in the pool.
+     *
+     * @param args arguments forwarded to the T constructor
+     * @return T* stable pointer to the new component
+     */
+    template <typename... Args>
+    T* emplace(Args&&... args) {
+        if (!freeSlots.empty()) {
+            size_t index = freeSlots.back();
+            reconstruct(index, std::forward<Args>(args)...);
+            freeSlots.pop_back();
+            live[index] = true;
+            return &slots[index];
+        }
+
+        slots.emplace_back(std::forward<Args>(args)...);
+        live.push_back(true);
+        return &slots.back();
+    }
+
+    /**
+     * @brief Erases a component from the pool.
+     *
+     * @param comp pointer previously returned by emplace()
+     * @return true the component was found and erased
+     * @return false the pointer does not belong to this pool
+     *
+     * @details
+     * The slot is reset to a default constructed T so any memory held by the
+     * component is released, then queued for reuse.
+     */
+    bool erase(const T* comp) {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (live[i] && &slots[i] == comp) {
+                reconstruct(i);
+                live[i] = false;
+                freeSlots.push_back(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Removes every component from the pool.
+     */
+    void clear() {
+        slots.clear();
+        live.clear();
+        freeSlots.clear();
+    }
+
+    /**
+     * @brief Number of live components in the pool.
+     */
+    size_t size() const noexcept { return slots.size() - freeSlots.size(); }
+
+    /**
+     * @brief Calls @p f on every live component in storage order.
+     *
+     * @param f callable taking T&
+     */
+    template <typename F>
+    void forEach(F&& f) {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (live[i]) {
+                f(slots[i]);
+            }
+        }
+    }
+};
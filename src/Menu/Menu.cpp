@@ -10,21 +10,91 @@
 
 #include "Menu.h"
 
+#include <algorithm>
+
+namespace {
+
+// Deletes the component behind a draw order entry from whichever storage owns
+// it.
+struct ComponentEraser {
+    std::vector<std::unique_ptr<Component>>& components;
+    ComponentPools& pools;
+
+    template <typename T>
+    void operator()(T* comp) {
+        std::get<ComponentPool<T>>(pools).erase(comp);
+    }
+
+    void operator()(Component* comp) {
+        components.erase(
+            std::remove_if(components.begin(), components.end(),
+                           [comp](const std::unique_ptr<Component>& ptr) {
+                               return ptr.get() == comp;
+                           }),
+            components.end());
+    }
+};
+
+}  // namespace
+
+void Menu::destroyComponent(const ComponentRef& ref) {
+    // Children of a viewport are owned by the menu, so delete them with it
+    if (Viewport* const* viewport = std::get_if<Viewport*>(&ref)) {
+        std::vector<ComponentRef> children = (*viewport)->getChildren();
+        for (const auto& child : children) {
+            destroyComponent(child);
+        }
+    }
+    std::visit(ComponentEraser{components, *pools}, ref);
+}
+
 bool Menu::removeComponent(size_t index) {
-    size_t oldSize = components.size();
-    if (index < components.size()) {
-        components.erase(components.begin() + index);
+    if (index >= drawOrder.size()) {
+        return false;
     }
-    return components.size() != oldSize;
+    ComponentRef ref = drawOrder[index];
+    drawOrder.erase(drawOrder.begin() + index);
+    destroyComponent(ref);
+    return true;
 }
 
 bool Menu::removeComponent(Component* comp) {
-    size_t oldSize = components.size();
-    components.erase(
-        std::remove_if(components.begin(), components.end(),
-                       [comp](const std::unique_ptr<Component>& ptr) {
-                           return ptr.get() == comp;
-                       }),
-        components.end());
-    return components.size() != oldSize;
-}
\ No newline at end of file
+    for (size_t i = 0; i < drawOrder.size(); ++i) {
+        if (toComponent(drawOrder[i]) == comp) {
+            return removeComponent(i);
+        }
+    }
+
+    // Not top-level, look for it among the children of viewports
+    std::optional<ComponentRef> child;
+    std::get<ComponentPool<Viewport>>(*pools).forEach([&](Viewport& viewport) {
+        if (child) {
+            return;
+        }
+        for (const auto& ref : viewport.getChildren()) {
+            if (toComponent(ref) == comp) {
+                child = ref;
+                viewport.removeChild(comp);
+                return;
+            }
+        }
+    });
+    if (!child) {
+        return false;
+    }
+    destroyComponent(*child);
+    return true;
+}
+
+void Menu::clearComponents() {
+    drawOrder.clear();
+    components.clear();
+
+    // Destroy the pools entirely before releasing the arena since they keep
+    // bookkeeping blocks allocated from it even when empty
+    layout.reset();
+    pools.reset();
+    arena.release();
+    createPools(
+        std::make_index_sequence<std::tuple_size_v<ComponentPools>>{});
+}
@@ -15,22 +15,87 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
+#include <tuple>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "../ColoredChar/ColoredChar.h"
+#include "../Component/AlbumAsciiArt/AlbumAsciiArt.h"
 #include "../Component/Component.h"
+#include "../Component/ComponentRef.h"
+#include "../Component/ListView/ListView.h"
+#include "../Component/SeekBar/SeekBar.h"
+#include "../Component/Text/Text.h"
+#include "../Component/Viewport/Viewport.h"
+#include "../Layout/Layout.h"
+#include "ComponentPool/ComponentPool.h"
+#include "MenuArena/MenuArena.h"
+
+/**
+ * @brief Pools holding the built-in components of a Menu, one per type.
+ */
+using ComponentPools =
+    std::tuple<ComponentPool<Text>, ComponentPool<SeekBar>,
+               ComponentPool<AlbumAsciiArt>, ComponentPool<ListView>,
+               ComponentPool<Viewport>>;
 
 /**
  * @class Menu
  *
  * @brief Represents a menu object. Holds components and handles rendering.
+ *
+ * @details
+ * Built-in components (Text, SeekBar, AlbumAsciiArt, ListView, Viewport)
+ * created with
+ * emplaceComponent() are stored in per-type pools so they sit next to each
+ * other in memory and are rendered without virtual calls. Custom components
+ * added with addComponent() are owned individually. Both kinds share a single
+ * draw order, and either kind can instead be placed inside a Viewport, which
+ * then draws it.
+ *
+ * Pooled components and their content are allocated from a per-menu arena
+ * that clearComponents() releases in one shot. getAllocationStats() reports
+ * what the current set of components cost to build.
  */
 class Menu {
    private:
+    MenuArena arena;  // Backs the pools, must outlive them
     std::vector<std::unique_ptr<Component>>
-        components;  // Components in the menu to render,
-                     // first component is bottommost
+        components;  // Custom components owned by the menu
+    std::optional<ComponentPools>
+        pools;  // Built-in components grouped by concrete type
+    std::optional<Layout> layout;  // Positions components, created on demand
+    std::vector<ComponentRef>
+        drawOrder;  // Top-level components in the menu to render,
+                    // first component is bottommost
+
+    /**
+     * @brief Adds a component to the draw order or to a viewport.
+     */
+    void attach(ComponentRef ref, Viewport* parent) {
+        if (parent != nullptr) {
+            parent->addChild(ref);
+        } else {
+            drawOrder.push_back(ref);
+        }
+    }
+
+    /**
+     * @brief Creates every pool drawing from the menu's arena.
+     */
+    template <size_t... I>
+    void createPools(std::index_sequence<I...>) {
+        pools.emplace(((void)I, &arena)...);
+    }
+
+    /**
+     * @brief Deletes a detached component, and its children if it is a
+     * viewport.
+     */
+    void destroyComponent(const ComponentRef& ref);
 
    protected:
     uint32_t width;
@@ -50,12 +115,18 @@ class Menu {
      * Creates a bordered frame and initializes the render buffer to the
      * given dimensions.
      */
-    Menu(uint32_t w, uint32_t h) : width(w), height(h){};
+    Menu(uint32_t w, uint32_t h)
+        : width(w), height(h) {
+        createPools(
+            std::make_index_sequence<std::tuple_size_v<ComponentPools>>{});
+    }
 
-    Menu(const Menu& other) = default;
-    Menu& operator=(Menu const& other) = default;
-    Menu(Menu&& other) noexcept = default;
-    Menu& operator=(Menu&& other) noexcept = default;
+    // Components point into the menu's arena, so Menu is non-copyable and
+    // non-movable
+    Menu(const Menu& other) = delete;
+    Menu& operator=(Menu const& other) = delete;
+    Menu(Menu&& other) noexcept = delete;
+    Menu& operator=(Menu&& other) noexcept = delete;
 
     ~Menu() = default;
 
@@ -66,18 +137,58 @@ class Menu {
      * @brief Adds a component to the menu.
      *
      * @param c Component to add. Ownership is transferred to the menu.
+     * @param parent viewport to add the component to, or nullptr to add it
+     * on top of the menu
      *
      * @details
      * This does not redraw the buffer. You must manually call a redraw.
      */
-    void addComponent(std::unique_ptr<Component> c) {
+    void addComponent(std::unique_ptr<Component> c,
+                      Viewport* parent = nullptr) {
+        attach(c.get(), parent);
         components.emplace_back(std::move(c));
     }
 
+    /**
+     * @brief Constructs a built-in component in the menu's pool for its type.
+     *
+     * @tparam T Text, SeekBar, AlbumAsciiArt, ListView or Viewport
+     * @param args arguments forwarded to the T constructor
+     * @return T* stable pointer to the component, valid until it is removed
+     *
+     * @details
+     * This does not redraw the buffer. You must manually call a redraw.
+     */
+    template <typename T, typename... Args>
+    T* emplaceComponent(Args&&... args) {
+        return emplaceComponentIn<T>(nullptr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs a built-in component inside a viewport.
+     *
+     * @tparam T Text, SeekBar, AlbumAsciiArt, ListView or Viewport
+     * @param parent viewport to add the component to, or nullptr to add it
+     * on top of the menu
+     * @param args arguments forwarded to the T constructor
+     * @return T* stable pointer to the component, valid until it is removed
+     *
+     * @details
+     * The component is owned by the menu and positioned relative to the
+     * viewport's content. This does not redraw the buffer.
+     */
+    template <typename T, typename... Args>
+    T* emplaceComponentIn(Viewport* parent, Args&&... args) {
+        T* comp = std::get<ComponentPool<T>>(*pools).emplace(
+            std::forward<Args>(args)...);
+        attach(comp, parent);
+        return comp;
+    }
+
     /**
      * @brief Removes and deletes a component from the menu given an index.
      *
-     * @param index index of the component to remove
+     * @param index index of the component to remove in draw order
      * @return true deletion occured
      * @return false no deletion occured
      *
@@ -89,7 +200,8 @@ class Menu {
     /**
      * @brief Removes and deletes a component from the menu given a pointer.
      *
-     * @param comp pointer of the desired component to remove
+     * @param comp pointer of the desired component to remove, may be the
+     * child of a viewport
      * @return true deletion occured
      * @return false no deletion occured
      *
@@ -102,16 +214,103 @@ class Menu {
      * @brief Clears all components from the menu.
      *
      * @details
+     * Every pooled component and the layout are destroyed and the menu's
+     * arena is released in one shot. Pointers to pooled components become
+     * invalid.
      * This does not redraw the buffer. You must manually call a redraw.
      */
-    void clearComponents() { components.clear(); }
+    void clearComponents();
 
     /**
-     * @brief Get the Components object
+     * @brief Get the menu's layout, creating an empty one on first use.
+     *
+     * @return Layout&
+     *
+     * @details
+     * The layout is allocated from the menu's arena and is discarded by
+     * clearComponents() along with the components it positions.
+     */
+    Layout& getLayout() {
+        if (!layout) {
+            layout.emplace(&arena);
+        }
+        return *layout;
+    }
+
+    /**
+     * @brief Recomputes the parts of the layout that changed.
+     *
+     * @param w width of the area inside the menu frame
+     * @param h height of the area inside the menu frame
+     * @return true if any component was moved or resized
+     *
+     * @details
+     * Does nothing if the menu has no layout or nothing changed.
+     */
+    bool updateLayout(uint32_t w, uint32_t h) {
+        return layout && layout->update({0, 0, w, h});
+    }
+
+    /**
+     * @brief Get the allocation counters of the menu's arena since the last
+     * clearComponents()
+     *
+     * @return const ArenaStats&
+     */
+    const ArenaStats& getAllocationStats() const noexcept {
+        return arena.getStats();
+    }
+
+    /**
+     * @brief Get the allocation counters of the arena cycle ended by the last
+     * clearComponents(), i.e. what the previous set of components cost
+     *
+     * @return const ArenaStats&
+     */
+    const ArenaStats& getLastRebuildStats() const noexcept {
+        return arena.getLastCycleStats();
+    }
+
+    /**
+     * @brief Get the menu's arena so related data (e.g. layout state) can be
+     * allocated alongside its components
+     *
+     * @return std::pmr::memory_resource*
+     */
+    std::pmr::memory_resource* getMemoryResource() noexcept { return &arena; }
+
+    /**
+     * @brief Get the custom components added with addComponent()
      *
      * @return std::vector<std::unique_ptr<Component>>&
      */
     std::vector<std::unique_ptr<Component>>& getComponents() {
         return components;
     }
+
+    /**
+     * @brief Get the top-level components in the menu in draw order
+     *
+     * @return const std::vector<ComponentRef>&
+     */
+    const std::vector<ComponentRef>& getDrawOrder() const noexcept {
+        return drawOrder;
+    }
+
+    /**
+     * @brief Calls @p visit on every component in draw order.
+     *
+     * @param visit callable accepting a pointer to each concrete component
+     * type listed in ComponentRef
+     *
+     * @details
+     * Built-in components are passed with their concrete type, so calls to
+     * their final pixelAt() are resolved at compile time.
+     */
+    template <typename Visitor>
+    void forEachComponent(Visitor&& visit) const {
+        for (const auto& ref : drawOrder) {
+            std::visit(visit, ref);
+        }
+    }
 };
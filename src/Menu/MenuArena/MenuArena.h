@@ -0,0 +1,133 @@
+/**
+ * @file MenuArena.h
+ * @author Amin Karic
+ * @brief Per-menu pooled memory arena with allocation statistics.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A MenuArena hands out memory for a menu's built-in components and their
+ * content from large blocks and frees everything at once when the menu is
+ * cleared, so rebuilding a view with thousands of small components costs a
+ * handful of system allocations.
+ *
+ * Blocks are carved into pools of fixed-size slots, and memory freed while the
+ * menu lives returns to its pool for the next allocation of that size.
+ * Content that is rebuilt all the time, such as a clock updated every
+ * second, therefore reuses the same slots, and a long-running menu stays
+ * bounded by its peak use. Allocations larger than the biggest pool slot come
+ * straight from the system allocator and are returned to it when freed.
+ *
+ * MenuArena performs no synchronization; a menu's components must only be
+ * modified from one thread at a time.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Allocation counters for one arena cycle (between two releases).
+ */
+struct ArenaStats {
+    size_t allocations = 0;     // Allocation requests served by the arena
+    size_t deallocations = 0;   // Deallocation requests, reused by the pools
+    size_t bytesAllocated = 0;  // Bytes handed out by the arena
+    size_t blocks = 0;          // Blocks requested from the system allocator
+    size_t bytesReserved = 0;   // Bytes requested from the system allocator
+};
+
+/**
+ * @class MenuArena
+ *
+ * @brief Pooled memory resource owned by a Menu.
+ */
+class MenuArena : public std::pmr::memory_resource {
+   private:
+    /**
+     * @brief Upstream resource that counts the blocks the arena requests.
+     */
+    class CountingUpstream : public std::pmr::memory_resource {
+       public:
+        ArenaStats* stats;  // Counters the blocks are added to
+
+        explicit CountingUpstream(ArenaStats* stats) : stats(stats) {}
+
+       private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++stats->blocks;
+            stats->bytesReserved += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    static constexpr size_t LARGEST_POOLED_BLOCK = 4096;
+
+    ArenaStats current;    // Counters since the last release()
+    ArenaStats lastCycle;  // Counters of the cycle ended by the last release()
+    CountingUpstream upstream;
+    std::pmr::unsynchronized_pool_resource pools;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++current.allocations;
+        current.bytesAllocated += bytes;
+        return pools.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++current.deallocations;
+        pools.deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   public:
+    MenuArena()
+        : upstream(&current),
+          pools(std::pmr::pool_options{0, LARGEST_POOLED_BLOCK}, &upstream) {}
+
+    // Memory handed out by the arena points into it, so it cannot be copied
+    // or moved
+    MenuArena(const MenuArena& other) = delete;
+    MenuArena& operator=(MenuArena const& other) = delete;
+    MenuArena(MenuArena&& other) noexcept = delete;
+    MenuArena& operator=(MenuArena&& other) noexcept = delete;
+
+    ~MenuArena() = default;
+
+    /**
+     * @brief Frees every block owned by the arena.
+     *
+     * @details
+     * All memory handed out by the arena becomes invalid. The counters of the
+     * finished cycle are kept and returned by getLastCycleStats().
+     */
+    void release() {
+        pools.release();
+        lastCycle = current;
+        current = ArenaStats{};
+    }
+
+    /**
+     * @brief Get the counters since the last release()
+     */
+    const ArenaStats& getStats() const noexcept { return current; }
+
+    /**
+     * @brief Get the counters of the cycle ended by the last release()
+     */
+    const ArenaStats& getLastCycleStats() const noexcept { return lastCycle; }
+};
@@ -0,0 +1,161 @@
+/**
+ * @file CellEncoder.cpp
+ * @author Amin Karic
+ * @brief CellEncoder implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for CellEncoder class.
+ */
+
+#include "CellEncoder.h"
+
+namespace {
+
+// SGR parameters of the attribute bits, in bit order
+constexpr const char* ATTRIBUTE_CODES[] = {"1", "2", "3", "4", "7"};
+constexpr size_t ATTRIBUTE_COUNT = 5;
+
+// Transparent backgrounds all mean the terminal's own
+uint32_t effectiveBackground(uint32_t rgba) noexcept {
+    return (rgba & 0xFF) == 0 ? 0 : rgba;
+}
+
+}  // namespace
+
+void CellEncoder::appendNumber(uint32_t n) {
+    char digits[10];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n != 0);
+    while (count > 0) {
+        buffer += digits[--count];
+    }
+}
+
+void CellEncoder::appendColor(uint32_t selector, uint32_t rgba) {
+    if (isPaletteColor(rgba)) {
+        // System colors have short codes of their own: 30-37 and 90-97 for
+        // the foreground, 40-47 and 100-107 for the background
+        uint32_t index = paletteIndex(rgba);
+        if (index < 8) {
+            appendNumber(selector - 8 + index);
+        } else if (index < 16) {
+            appendNumber(selector + 52 + index - 8);
+        } else {
+            appendNumber(selector);
+            buffer += ";5;";
+            appendNumber(index);
+        }
+        return;
+    }
+    appendNumber(selector);
+    buffer += ";2;";
+    appendNumber((rgba >> 24) & 0xFF);
+    buffer += ';';
+    appendNumber((rgba >> 16) & 0xFF);
+    buffer += ';';
+    appendNumber((rgba >> 8) & 0xFF);
+}
+
+void CellEncoder::setStyle(const ColoredChar& cell) {
+    uint32_t cellFG = Palette::nearest(tier, cell.rgba_fg);
+    uint32_t cellBG =
+        Palette::nearest(tier, effectiveBackground(cell.rgba_bg));
+    if (styled && cellFG == fg && cellBG == bg && cell.attrs == attrs) {
+        return;
+    }
+
+    // Attributes can only be turned off as a group, by a reset that also
+    // clears the colors
+    bool full = !styled || (attrs & ~cell.attrs) != 0;
+    buffer += "\x1b[";
+    bool first = true;
+    auto separate = [this, &first] {
+        if (!first) {
+            buffer += ';';
+        }
+        first = false;
+    };
+
+    if (full) {
+        buffer += '0';
+        first = false;
+    }
+    uint8_t added = full ? cell.attrs : cell.attrs & ~attrs;
+    for (size_t bit = 0; bit < ATTRIBUTE_COUNT; ++bit) {
+        if (added & (1 << bit)) {
+            separate();
+            buffer += ATTRIBUTE_CODES[bit];
+        }
+    }
+    if (full || cellFG != fg) {
+        separate();
+        appendColor(38, cellFG);
+    }
+    if (cellBG != 0 && (full || cellBG != bg)) {
+        separate();
+        appendColor(48, cellBG);
+    } else if (cellBG == 0 && !full && bg != 0) {
+        separate();
+        buffer += "49";
+    }
+    buffer += 'm';
+
+    styled = true;
+    fg = cellFG;
+    bg = cellBG;
+    attrs = cell.attrs;
+}
+
+void CellEncoder::moveTo(int32_t row, int32_t col) {
+    // Terminal rows and columns start at 1
+    buffer += "\x1b[";
+    appendNumber(static_cast<uint32_t>(row + 1));
+    buffer += ';';
+    appendNumber(static_cast<uint32_t>(col + 1));
+    buffer += 'H';
+}
+
+void CellEncoder::put(const ColoredChar& cell) {
+    if (cell.c == CCHAR_CONTINUATION) {
+        return;
+    }
+    setStyle(cell);
+
+    if (ClusterTable::isCluster(cell.c)) {
+        buffer += toUTF8(cell.c);
+        return;
+    }
+    uint32_t code = static_cast<uint32_t>(cell.c);
+    if (code < 0x80) {
+        buffer += static_cast<char>(code);
+    } else if (code < 0x800) {
+        buffer += static_cast<char>(0xC0 | (code >> 6));
+        buffer += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        buffer += static_cast<char>(0xE0 | (code >> 12));
+        buffer += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        buffer += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        buffer += static_cast<char>(0xF0 | (code >> 18));
+        buffer += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        buffer += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        buffer += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+void CellEncoder::resetStyle() {
+    if (styled) {
+        buffer += ANSI_RESET;
+        styled = false;
+    }
+}
+
+void CellEncoder::flush(std::ostream& os) {
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
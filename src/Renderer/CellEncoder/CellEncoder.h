@@ -0,0 +1,135 @@
+/**
+ * @file CellEncoder.h
+ * @author Amin Karic
+ * @brief CellEncoder class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Writing each cell as its own attribute, foreground and background escape
+ * followed by a reset costs over 40 bytes per cell, most of it repeated:
+ * neighbouring cells of text share a style, and so do many neighbouring
+ * cells of album art once it has been downscaled. The CellEncoder remembers
+ * the style the terminal is in and only emits the parts of an SGR sequence
+ * that change, merged into one escape, so runs of equal cells cost one byte
+ * per ASCII character. Output is collected in a reused buffer and written
+ * with a single call.
+ *
+ * On terminals without truecolor, RGB colors are mapped to the nearest
+ * palette entry here, and palette colors are written as palette escapes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "../../ColoredChar/ColoredChar.h"
+#include "../../ColoredChar/Palette/Palette.h"
+
+/**
+ * @class CellEncoder
+ *
+ * @brief Encodes cells as terminal output with coalesced SGR sequences.
+ */
+class CellEncoder {
+   private:
+    std::string buffer;   // Output not yet written
+    bool styled = false;  // Whether the terminal's style is known
+    uint32_t fg = 0;      // Terminal foreground when styled
+    uint32_t bg = 0;      // Terminal background when styled, 0 for default
+    uint8_t attrs = 0;    // Terminal attributes when styled
+    ColorTier tier = ColorTier::TrueColor;  // Colors the terminal shows
+
+    /**
+     * @brief Appends a decimal number.
+     */
+    void appendNumber(uint32_t n);
+
+    /**
+     * @brief Appends an SGR color parameter, e.g. 38;2;r;g;b or 38;5;n.
+     *
+     * @param selector 38 for foreground, 48 for background
+     * @param rgba RGB color, the alpha is ignored, or a palette color
+     */
+    void appendColor(uint32_t selector, uint32_t rgba);
+
+    /**
+     * @brief Switches the terminal to the style of a cell.
+     */
+    void setStyle(const ColoredChar& cell);
+
+   public:
+    CellEncoder() = default;
+
+    /**
+     * @brief Sets the colors the terminal shows, RGB colors are mapped to
+     * the nearest palette entry unless it is TrueColor.
+     *
+     * @param t colors the terminal shows
+     */
+    void setColorTier(ColorTier t) noexcept {
+        tier = t;
+        styled = false;
+    }
+
+    /**
+     * @brief Returns the colors the terminal shows.
+     */
+    ColorTier getColorTier() const noexcept { return tier; }
+
+    /**
+     * @brief Moves the cursor.
+     *
+     * @param row frame row, 0 based
+     * @param col frame column, 0 based
+     */
+    void moveTo(int32_t row, int32_t col);
+
+    /**
+     * @brief Appends a cell, changing only the parts of the style that
+     * differ from the previous cell.
+     *
+     * @param cell cell to write, continuation cells write nothing
+     */
+    void put(const ColoredChar& cell);
+
+    /**
+     * @brief Appends raw output such as a newline or a screen clear.
+     *
+     * @details The text must not change the style, use resetStyle() first
+     * if it depends on it.
+     */
+    void append(std::string_view text) { buffer.append(text); }
+
+    /**
+     * @brief Resets the terminal style if any was set.
+     */
+    void resetStyle();
+
+    /**
+     * @brief Forgets the terminal's style, as after output that the encoder
+     * did not write.
+     */
+    void invalidate() noexcept { styled = false; }
+
+    /**
+     * @brief Writes the collected output, keeping the buffer's capacity.
+     *
+     * @param os stream to write to
+     */
+    void flush(std::ostream& os);
+
+    /**
+     * @brief Returns the collected output.
+     */
+    std::string_view view() const noexcept { return buffer; }
+
+    /**
+     * @brief Drops the collected output.
+     */
+    void clear() noexcept { buffer.clear(); }
+};
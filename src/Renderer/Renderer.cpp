@@ -10,6 +10,107 @@
 
 #include "Renderer.h"
 
+#include <variant>
+
+#include "../Component/AlbumAsciiArt/AlbumAsciiArt.h"
+#include "../Component/ListView/ListView.h"
+#include "../Component/SeekBar/SeekBar.h"
+#include "../Component/Text/Text.h"
+#include "../Component/Viewport/Viewport.h"
+#include "../Unicode/DisplayWidth/DisplayWidth.h"
+
+namespace {
+
+// Whether a component or anything inside it needs redrawing
+struct DirtyCheck {
+    bool operator()(const Component* c) const { return c->isDirty(); }
+
+    bool operator()(const Viewport* v) const {
+        if (v->isDirty()) {
+            return true;
+        }
+        for (const auto& child : v->getChildren()) {
+            if (std::visit(*this, child)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Records where a component and its children were drawn
+struct MarkDrawn {
+    const Surface& surface;
+
+    void operator()(Component* c) const {
+        c->markDrawn(surface.visibleRect(c->getX(), c->getY(), c->getWidth(),
+                                         c->getHeight()));
+    }
+
+    void operator()(Viewport* v) const {
+        (*this)(static_cast<Component*>(v));
+        Surface inner = surface.child(v->getX(), v->getY(), v->getWidth(),
+                                      v->getHeight(), v->getScrollX(),
+                                      v->getScrollY());
+        for (const auto& child : v->getChildren()) {
+            std::visit(MarkDrawn{inner}, child);
+        }
+    }
+};
+
+// Adds a rectangle to the damage list, merging it with any it overlaps
+void addDamage(std::vector<ClipRect>& damage, ClipRect rect) {
+    if (rect.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < damage.size();) {
+        if (!damage[i].intersect(rect).empty()) {
+            rect = rect.unite(damage[i]);
+            damage[i] = damage.back();
+            damage.pop_back();
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+    damage.push_back(rect);
+}
+
+// Prints a span of a frame row. A wide character only prints when its
+// continuation cell follows it, and a continuation only stays silent after its
+// wide character, so halves split by clipping or overlap print as blanks and
+// never shift the rest of the row.
+void writeCells(CellEncoder& out, const ColoredChar* row, int32_t from,
+                int32_t to) {
+    for (int32_t x = from; x < to; ++x) {
+        const ColoredChar& cell = row[x];
+        uint32_t width = displayWidth(cell.c);
+        if (width == 1) {
+            out.put(cell);
+            continue;
+        }
+
+        bool paired;
+        if (cell.c == CCHAR_CONTINUATION) {
+            paired = x > from && displayWidth(row[x - 1].c) == 2;
+        } else {
+            paired = width == 2 && x + 1 < to &&
+                     row[x + 1].c == CCHAR_CONTINUATION;
+        }
+        if (paired) {
+            out.put(cell);
+        } else {
+            // Unpaired halves and zero width characters would misalign
+            // the terminal cursor
+            ColoredChar blank = cell;
+            blank.c = U' ';
+            out.put(blank);
+        }
+    }
+}
+
+}  // namespace
+
 bool Renderer::setActive(size_t index) {
     bool set = false;
     {
@@ -111,17 +212,83 @@ void Renderer::requestRedraw() {
     cv.notify_one();
 }
 
+TimerId Renderer::scheduleOnce(std::chrono::milliseconds delay,
+                               std::function<void()> callback) {
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        id = timers.scheduleOnce(delay, std::move(callback));
+        timersChanged = true;
+    }
+    cv.notify_one();
+    return id;
+}
+
+TimerId Renderer::schedulePeriodic(std::chrono::milliseconds interval,
+                                   std::function<void()> callback) {
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        id = timers.schedulePeriodic(interval, std::move(callback));
+        timersChanged = true;
+    }
+    cv.notify_one();
+    return id;
+}
+
+bool Renderer::cancelTimer(TimerId id) {
+    // No need to wake the loop, an early wakeup just finds nothing due
+    std::lock_guard<std::mutex> lock(mtx);
+    return timers.cancel(id);
+}
+
+void Renderer::requestPartialRedraw() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        damaged = true;
+    }
+    cv.notify_one();
+}
+
 void Renderer::run() {
     std::unique_lock<std::mutex> lock(mtx);
+    auto wake = [this] {
+        return dirty || damaged || !running || timersChanged;
+    };
 
     while (running) {
-        cv.wait(lock, [this] { return dirty || !running; });
+        std::optional<TimerClock::time_point> deadline =
+            timers.nextDeadline();
+        if (deadline) {
+            cv.wait_until(lock, *deadline, wake);
+        } else {
+            cv.wait(lock, wake);
+        }
         if (!running) {
             break;
         }
+        timersChanged = false;
+
+        // Callbacks run unlocked so they can schedule timers and request
+        // redraws
+        timers.advance(TimerClock::now(), dueTimers);
+        if (!dueTimers.empty()) {
+            lock.unlock();
+            for (const auto& callback : dueTimers) {
+                (*callback)();
+            }
+            lock.lock();
+            dueTimers.clear();
+        }
+
+        if (!dirty && !damaged) {
+            continue;
+        }
+        bool full = dirty;
         dirty = false;
+        damaged = false;
         lock.unlock();
-        draw();
+        draw(full);
         lock.lock();
     }
 };
@@ -134,85 +301,159 @@ void Renderer::stop() {
     cv.notify_one();
 };
 
-void Renderer::draw() {
-    if (activeMenu < menus.size()) {
-        Menu* targetMenu = menus[activeMenu];
-        size_t menuWidth = targetMenu->getWidth();
-                // Reserve one terminal row for input to prevent scrolling
-        size_t menuHeight = targetMenu->getHeight() - 1;
+void Renderer::draw(bool full) {
+    if (activeMenu >= menus.size()) {
+        return;
+    }
+    Menu* targetMenu = menus[activeMenu];
+    size_t menuWidth = targetMenu->getWidth();
+    // Reserve one terminal row for input to prevent scrolling
+    size_t menuHeight = targetMenu->getHeight() - 1;
 
-        outputBuffer.resize(menuHeight, std::vector<ColoredChar>(menuWidth));
+    // What is on screen is unknown if the frame changed size
+    if (frame.size() != menuWidth * menuHeight) {
+        full = true;
+    }
 
-        // Clear buffer
-        for (auto& row : outputBuffer) {
-            for (auto& c : row) {
-                c = BLANK_CHARACTER;
-            }
-        }
+    // Reposition components if the layout changed, this is a no-op when
+    // nothing did. Moved components are marked dirty.
+    targetMenu->updateLayout(menuWidth - 2, menuHeight - 2);
+
+    // Objects are placed inside the frame, so the surface is clipped to the
+    // inside of the border and its origin is offset by 1
+    ClipRect inside{1, 1, static_cast<int32_t>(menuWidth) - 1,
+                    static_cast<int32_t>(menuHeight) - 1};
+
+    if (full) {
+        frame.assign(menuWidth * menuHeight, BLANK_CHARACTER);
+        auto cell = [&](size_t x, size_t y) -> ColoredChar& {
+            return frame[y * menuWidth + x];
+        };
 
         // Draw corners
-        outputBuffer[0][0] = ColoredChar(U'┌', CCHAR_WHITE);
-        outputBuffer[0][menuWidth - 1] = ColoredChar(U'┐', CCHAR_WHITE);
-        outputBuffer[menuHeight - 1][0] = ColoredChar(U'└', CCHAR_WHITE);
-        outputBuffer[menuHeight - 1][menuWidth - 1] =
-            ColoredChar(U'┘', CCHAR_WHITE);
+        cell(0, 0) = ColoredChar(U'┌', CCHAR_WHITE);
+        cell(menuWidth - 1, 0) = ColoredChar(U'┐', CCHAR_WHITE);
+        cell(0, menuHeight - 1) = ColoredChar(U'└', CCHAR_WHITE);
+        cell(menuWidth - 1, menuHeight - 1) = ColoredChar(U'┘', CCHAR_WHITE);
 
         // Draw top and bottom edges
-        for (auto i = 1; i < menuWidth - 1; ++i) {
-            outputBuffer[0][i] = ColoredChar(U'─', CCHAR_WHITE);
-            outputBuffer[menuHeight - 1][i] = ColoredChar(U'─', CCHAR_WHITE);
+        for (size_t i = 1; i < menuWidth - 1; ++i) {
+            cell(i, 0) = ColoredChar(U'─', CCHAR_WHITE);
+            cell(i, menuHeight - 1) = ColoredChar(U'─', CCHAR_WHITE);
         }
 
         // Draw left and right edges
-        for (auto i = 1; i < menuHeight - 1; ++i) {
-            outputBuffer[i][0] = ColoredChar(U'│', CCHAR_WHITE);
-            outputBuffer[i][menuWidth - 1] = ColoredChar(U'│', CCHAR_WHITE);
-        }
-
-        // Put the updated components into the render buffer
-        for (const auto& comp : targetMenu->getComponents()) {
-            for (uint32_t y = 0; y < comp->getHeight(); ++y) {
-                for (uint32_t x = 0; x < comp->getWidth(); ++x) {
-                    // Objects are placed inside the frame, so offset by 1
-                    int bufX = comp->getX() + x + 1;
-                    int bufY = comp->getY() + y + 1;
-
-                    // Range check, only render if inside the buffer
-                    if (bufX > 0 && bufX < menuWidth - 1 && bufY > 0 &&
-                        bufY < menuHeight - 1) {
-                        outputBuffer[bufY][bufX] = comp->pixelAt(x, y);
-                    }
-                }
+        for (size_t i = 1; i < menuHeight - 1; ++i) {
+            cell(0, i) = ColoredChar(U'│', CCHAR_WHITE);
+            cell(menuWidth - 1, i) = ColoredChar(U'│', CCHAR_WHITE);
+        }
+    }
+
+    Surface surface(frame.data(), static_cast<uint32_t>(menuWidth), inside, 1,
+                    1);
+
+    if (full) {
+        // Put the updated components into the render buffer. Built-in
+        // components arrive with their concrete type so their final blit()
+        // and pixelAt() are resolved at compile time.
+        targetMenu->forEachComponent(
+            [&surface](const auto* comp) { comp->blit(surface); });
+
+        encoder.append("\x1b[3J\x1b[2J\x1b[H");  // Clears the screen
+
+        for (size_t y = 0; y < menuHeight; ++y) {
+            writeCells(encoder, surface.row(static_cast<int32_t>(y)), 0,
+                       static_cast<int32_t>(menuWidth));
+            encoder.append("\n");
+        }
+    } else {
+        drawDamage(*targetMenu, surface);
+    }
+
+    for (const auto& ref : targetMenu->getDrawOrder()) {
+        std::visit(MarkDrawn{surface}, ref);
+    }
+
+    // The whole frame goes out in one write, leaving the terminal unstyled
+    // for the input line
+    encoder.resetStyle();
+    encoder.flush(std::cout);
+
+    drawInputLine(menuHeight);
+};
+
+void Renderer::drawDamage(const Menu& menu, const Surface& surface) {
+    // A dirty component damages both where it was and where it is now,
+    // unless it stayed in place and only part of it changed
+    std::vector<ClipRect> damage;
+    for (const auto& ref : menu.getDrawOrder()) {
+        if (!std::visit(DirtyCheck{}, ref)) {
+            continue;
+        }
+        const Component* c = toComponent(ref);
+        ClipRect now = surface.visibleRect(c->getX(), c->getY(),
+                                           c->getWidth(), c->getHeight());
+        if (c->isDirty() && now == c->getDrawnRect()) {
+            ClipRect area = c->getDirtyArea();
+            if (area.empty()) {
+                continue;
             }
+            addDamage(damage,
+                      surface.visibleRect(
+                          c->getX() + area.left, c->getY() + area.top,
+                          static_cast<uint32_t>(area.right - area.left),
+                          static_cast<uint32_t>(area.bottom - area.top)));
+            continue;
         }
+        addDamage(damage, c->getDrawnRect().intersect(surface.getClip()));
+        addDamage(damage, now);
+    }
 
-        std::cout << "\x1b[3J\x1b[2J\x1b[H";  // Clears the screen
+    for (const ClipRect& rect : damage) {
+        // Redraw everything overlapping the damaged area, clipped to it
+        Surface damaged = surface.clipped(rect);
+        damaged.fill(rect, BLANK_CHARACTER);
+        menu.forEachComponent(
+            [&damaged](const auto* comp) { comp->blit(damaged); });
 
-        for (const auto& row : outputBuffer) {
-            for (const auto& pixel : row) {
-                std::cout << pixel;
+        for (int32_t fy = rect.top; fy < rect.bottom; ++fy) {
+            // A wide character straddling an edge of the damage is reprinted
+            // whole, since writing over half of it on the terminal erases it.
+            // The border keeps both neighbours inside the frame.
+            const ColoredChar* row = surface.row(fy);
+            int32_t from = rect.left;
+            int32_t to = rect.right;
+            if (displayWidth(row[from - 1].c) == 2) {
+                --from;
+            }
+            if (row[to].c == CCHAR_CONTINUATION) {
+                ++to;
             }
-            std::cout << '\n';
+
+            encoder.moveTo(fy, from);
+            writeCells(encoder, row, from, to);
         }
+    }
+}
 
-        // ---- Input line handling (FIXES DUPLICATION) ----
-        // Input line is directly below the menu
-        const size_t inputRow = menuHeight;  // last visible row
-        const size_t inputCol = 1;               // start at column 1
+void Renderer::drawInputLine(size_t menuHeight) {
+    // ---- Input line handling (FIXES DUPLICATION) ----
+    // Input line is directly below the menu
+    const size_t inputRow = menuHeight;  // last visible row
+    const size_t inputCol = 1;           // start at column 1
 
-        // Move cursor to input line
-        std::cout << "\x1b[" << inputRow << ";" << inputCol << "H";
+    // Move cursor to input line
+    std::cout << "\x1b[" << inputRow << ";" << inputCol << "H";
 
-        // Clear the entire input line
-        std::cout << "\x1b[2K";
+    // Clear the entire input line
+    std::cout << "\x1b[2K";
 
-        // Print input buffer
-        std::cout << inputState.buffer;
+    // Print input buffer
+    std::cout << inputState.buffer;
 
-        // Place cursor at end of buffer (simple echo behavior)
-        std::cout << "\x1b[" << inputRow << ";"
-                  << (inputCol + inputState.buffer.size()) << "H";
+    // Place cursor at end of buffer (simple echo behavior)
+    std::cout << "\x1b[" << inputRow << ";"
+              << (inputCol + inputState.buffer.size()) << "H";
 
-        std::cout << std::flush;
-    }
-};
\ No newline at end of file
+    std::cout << std::flush;
+}
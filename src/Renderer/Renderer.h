@@ -15,13 +15,18 @@
  */
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include "../Menu/Menu.h"
+#include "CellEncoder/CellEncoder.h"
 #include "../TextInput/InputState/InputState.h"
+#include "../TimerWheel/TimerWheel.h"
 
 /**
  * @class Renderer
@@ -35,25 +40,53 @@
  * The Renderer is thread-safe and intended to be interacted with by background
  * services via requestRedraw(), while all rendering and terminal output occurs
  * on the renderer thread.
+ *
+ * Timed work such as clocks, progress updates and animations is scheduled on
+ * the renderer's timer wheel instead of on sleeping threads. The render loop
+ * sleeps until the earliest timer is due, or indefinitely when none are
+ * scheduled, so an idle player uses no CPU.
  */
 class Renderer {
    private:
     std::vector<Menu*> menus;    // Pointers to Menus rendered by this renderer
     size_t activeMenu;           // Index of the active menu
     bool dirty = true;           // Indicates if redraw requested
+    bool damaged = false;        // Indicates if partial redraw requested
     bool running = true;         // Controls the lifetime of the render loop
     std::mutex mtx;              // Protects shared renderer state
     std::condition_variable cv;  // Used to sleep/wake the render loop
     InputState& inputState;      // Object tracking input data
-    std::vector<std::vector<ColoredChar>>
-        outputBuffer;
+    std::vector<ColoredChar> frame;  // Composed menu cells, row-major
+    CellEncoder encoder;  // Terminal output of a draw, reused between draws
+    TimerWheel timers;           // Timed callbacks run by the render loop
+    bool timersChanged = false;  // Wakes the loop to recompute its deadline
+    std::vector<std::shared_ptr<const TimerWheel::Callback>>
+        dueTimers;  // Callbacks collected by the last advance of the wheel
 
     /**
      * @brief Render and output the active menu once.
      *
      * Generates the menu buffer and writes it to the terminal.
+     *
+     * @param full redraw everything if true, otherwise only the areas covered
+     * by dirty components now or when they were last drawn
+     */
+    void draw(bool full);
+
+    /**
+     * @brief Recompose and output only the damaged areas of the frame.
+     *
+     * @param menu menu being drawn
+     * @param surface surface covering the inside of the menu border
+     */
+    void drawDamage(const Menu& menu, const Surface& surface);
+
+    /**
+     * @brief Output the input line below the menu and place the cursor.
+     *
+     * @param menuHeight number of rows the menu occupies
      */
-    void draw();
+    void drawInputLine(size_t menuHeight);
 
    public:
     // Requires refrences therefore we cannot have default ctor
@@ -144,17 +177,71 @@ class Renderer {
      */
     bool removeMenu(Menu* m);
 
+    /**
+     * @brief Set the colors the terminal shows.
+     *
+     * Call before run(), RGB colors are written as the nearest palette
+     * entry unless the tier is TrueColor.
+     *
+     * @param tier colors the terminal shows, see Palette::detect()
+     */
+    void setColorTier(ColorTier tier) noexcept { encoder.setColorTier(tier); }
+
     /**
      * @brief Request that the renderer redraw the active menu.
      *
      */
     void requestRedraw();
 
+    /**
+     * @brief Request that the renderer redraw the dirty components only.
+     *
+     * Mark the changed components with Component::markDirty() first. The areas
+     * they cover now and covered in the last frame are recomposed and written
+     * to the terminal, everything else is left untouched. Use requestRedraw()
+     * when components were added or removed.
+     */
+    void requestPartialRedraw();
+
+    /**
+     * @brief Schedule a callback to run once on the renderer thread.
+     *
+     * @param delay time until the callback runs
+     * @param callback function to run, call requestRedraw() from it when it
+     * changes what is shown
+     * @return TimerId id that can be passed to cancelTimer()
+     */
+    TimerId scheduleOnce(std::chrono::milliseconds delay,
+                         std::function<void()> callback);
+
+    /**
+     * @brief Schedule a callback to run repeatedly on the renderer thread.
+     *
+     * @param interval time between runs
+     * @param callback function to run, call requestRedraw() from it when it
+     * changes what is shown
+     * @return TimerId id that can be passed to cancelTimer()
+     */
+    TimerId schedulePeriodic(std::chrono::milliseconds interval,
+                             std::function<void()> callback);
+
+    /**
+     * @brief Cancel a scheduled callback.
+     *
+     * A callback already collected for the current pass of the render loop
+     * still runs once.
+     *
+     * @param id id returned by scheduleOnce() or schedulePeriodic()
+     * @return bool true if the timer was pending, false otherwise
+     */
+    bool cancelTimer(TimerId id);
+
     /**
      * @brief Run the renderer loop.
      *
      * Blocks the calling thread until stop() is called. The renderer sleeps
-     * when no redraw is requested and wakes when notified.
+     * until a redraw is requested or the next timer is due, and runs due timer
+     * callbacks before drawing.
      */
     void run();
 
@@ -0,0 +1,187 @@
+/**
+ * @file Surface.h
+ * @author Amin Karic
+ * @brief Clipped view into the renderer's frame buffer.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A Surface is a small value type made of a pointer into the frame buffer, a
+ * clip rectangle and an origin. Containers derive child surfaces by
+ * intersecting the clip rectangle and shifting the origin, so nested
+ * containers never copy cells. Components blit into a surface by computing
+ * their visible rectangle once and then writing whole rows without per-cell
+ * bounds checks.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../../ColoredChar/ColoredChar.h"
+
+/**
+ * @brief Rectangle in frame coordinates, right and bottom are exclusive.
+ */
+struct ClipRect {
+    int32_t left = 0;
+    int32_t top = 0;
+    int32_t right = 0;
+    int32_t bottom = 0;
+
+    bool empty() const noexcept { return right <= left || bottom <= top; }
+
+    bool operator==(const ClipRect& other) const noexcept {
+        return left == other.left && top == other.top &&
+               right == other.right && bottom == other.bottom;
+    }
+
+    bool operator!=(const ClipRect& other) const noexcept {
+        return !(*this == other);
+    }
+
+    ClipRect intersect(const ClipRect& other) const noexcept {
+        return {std::max(left, other.left), std::max(top, other.top),
+                std::min(right, other.right), std::min(bottom, other.bottom)};
+    }
+
+    ClipRect unite(const ClipRect& other) const noexcept {
+        if (empty()) {
+            return other;
+        }
+        if (other.empty()) {
+            return *this;
+        }
+        return {std::min(left, other.left), std::min(top, other.top),
+                std::max(right, other.right), std::max(bottom, other.bottom)};
+    }
+};
+
+/**
+ * @class Surface
+ *
+ * @brief Clipped, translated view of a frame buffer.
+ */
+class Surface {
+   private:
+    ColoredChar* cells;  // First cell of the frame buffer
+    uint32_t stride;     // Cells per frame row
+    ClipRect clip;       // Writable area in frame coordinates
+    int32_t originX;     // Frame x of local coordinate 0
+    int32_t originY;     // Frame y of local coordinate 0
+
+   public:
+    /**
+     * @brief Construct a new Surface object
+     *
+     * @param cells first cell of a row-major frame buffer
+     * @param stride number of cells per row
+     * @param clip writable area in frame coordinates
+     * @param originX frame x coordinate of local x = 0
+     * @param originY frame y coordinate of local y = 0
+     */
+    Surface(ColoredChar* cells, uint32_t stride, ClipRect clip,
+            int32_t originX, int32_t originY)
+        : cells(cells),
+          stride(stride),
+          clip(clip),
+          originX(originX),
+          originY(originY) {}
+
+    const ClipRect& getClip() const noexcept { return clip; }
+    int32_t getOriginX() const noexcept { return originX; }
+    int32_t getOriginY() const noexcept { return originY; }
+
+    /**
+     * @brief Returns the part of a local rectangle that is visible, in frame
+     * coordinates.
+     */
+    ClipRect visibleRect(int32_t x, int32_t y, uint32_t w,
+                         uint32_t h) const noexcept {
+        ClipRect r{originX + x, originY + y,
+                   originX + x + static_cast<int32_t>(w),
+                   originY + y + static_cast<int32_t>(h)};
+        return r.intersect(clip);
+    }
+
+    /**
+     * @brief Derives the surface for a container's contents.
+     *
+     * @param x local x coordinate of the container
+     * @param y local y coordinate of the container
+     * @param w container width
+     * @param h container height
+     * @param scrollX horizontal scroll offset of the contents
+     * @param scrollY vertical scroll offset of the contents
+     * @return Surface clipped to both this surface and the container
+     */
+    Surface child(int32_t x, int32_t y, uint32_t w, uint32_t h,
+                  int32_t scrollX = 0, int32_t scrollY = 0) const noexcept {
+        return Surface(cells, stride, visibleRect(x, y, w, h),
+                       originX + x - scrollX, originY + y - scrollY);
+    }
+
+    /**
+     * @brief Returns the same surface restricted to a smaller clip rectangle.
+     *
+     * @param rect area in frame coordinates to restrict drawing to
+     */
+    Surface clipped(const ClipRect& rect) const noexcept {
+        return Surface(cells, stride, clip.intersect(rect), originX, originY);
+    }
+
+    /**
+     * @brief Pointer to the first cell of a frame row.
+     *
+     * @param frameY row in frame coordinates, must be inside the clip
+     */
+    ColoredChar* row(int32_t frameY) const noexcept {
+        return cells + static_cast<size_t>(frameY) * stride;
+    }
+
+    /**
+     * @brief Fills a rectangle in frame coordinates, clipped to the surface.
+     */
+    void fill(const ClipRect& rect, const ColoredChar& c) const noexcept {
+        ClipRect r = rect.intersect(clip);
+        if (r.empty()) {
+            return;
+        }
+        for (int32_t fy = r.top; fy < r.bottom; ++fy) {
+            std::fill(row(fy) + r.left, row(fy) + r.right, c);
+        }
+    }
+};
+
+/**
+ * @brief Copies a component's pixels into a surface.
+ *
+ * @tparam T component type, when it is a concrete type with a final pixelAt()
+ * the call is resolved at compile time
+ * @param comp component to draw
+ * @param surface surface to draw into
+ *
+ * @details
+ * The visible rectangle is computed once, so the inner loop performs no bounds
+ * checks.
+ */
+template <typename T>
+inline void blitPixels(const T& comp, const Surface& surface) {
+    int32_t x = static_cast<int32_t>(comp.getX());
+    int32_t y = static_cast<int32_t>(comp.getY());
+    ClipRect r = surface.visibleRect(x, y, comp.getWidth(), comp.getHeight());
+    if (r.empty()) {
+        return;
+    }
+
+    int32_t baseX = surface.getOriginX() + x;
+    int32_t baseY = surface.getOriginY() + y;
+    for (int32_t fy = r.top; fy < r.bottom; ++fy) {
+        ColoredChar* out = surface.row(fy);
+        int32_t localY = fy - baseY;
+        for (int32_t fx = r.left; fx < r.right; ++fx) {
+            out[fx] = comp.pixelAt(fx - baseX, localY);
+        }
+    }
+}
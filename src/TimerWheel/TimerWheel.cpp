@@ -0,0 +1,200 @@
+/**
+ * @file TimerWheel.cpp
+ * @author Amin Karic
+ * @brief Hierarchical timer wheel implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+namespace {
+
+using Tick = std::chrono::milliseconds;
+
+// Index of the first set bit at or after `start`, wrapping around
+size_t firstSetFrom(uint64_t bits, size_t start) {
+    uint64_t rotated = (bits >> start) | (start == 0 ? 0 : bits << (64 - start));
+    return (static_cast<size_t>(__builtin_ctzll(rotated)) + start) & 63;
+}
+
+}  // namespace
+
+uint64_t TimerWheel::ticksUntil(TimerClock::time_point t) const {
+    if (t <= epoch) {
+        return 0;
+    }
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<Tick>(t - epoch).count());
+}
+
+TimerId TimerWheel::add(TimerClock::duration delay,
+                        TimerClock::duration period, Callback callback,
+                        TimerClock::time_point now) {
+    uint64_t nowTick = ticksUntil(now);
+    if (timers.empty() && nowTick > currentTick) {
+        // Nothing to process in between, so catch up for free
+        currentTick = nowTick;
+    }
+
+    // Round up so a timer never fires early
+    uint64_t delayTicks = static_cast<uint64_t>(
+        std::chrono::ceil<Tick>(std::max(delay, TimerClock::duration::zero()))
+            .count());
+    uint64_t periodTicks = static_cast<uint64_t>(
+        std::chrono::ceil<Tick>(std::max(period, TimerClock::duration::zero()))
+            .count());
+    if (period > TimerClock::duration::zero()) {
+        periodTicks = std::max<uint64_t>(periodTicks, 1);
+    }
+
+    TimerId id = nextId++;
+    Timer& timer = timers[id];
+    timer.expiry = std::max(nowTick + delayTicks, currentTick + 1);
+    timer.period = periodTicks;
+    timer.callback = std::make_shared<const Callback>(std::move(callback));
+    place(id, timer);
+    return id;
+}
+
+void TimerWheel::place(TimerId id, Timer& timer) {
+    uint64_t delta =
+        timer.expiry > currentTick ? timer.expiry - currentTick : 0;
+
+    size_t level = 0;
+    while (level + 1 < LEVELS && delta >= (uint64_t{1} << (SLOT_BITS *
+                                                           (level + 1)))) {
+        ++level;
+    }
+
+    uint64_t expiry = timer.expiry;
+    uint64_t range = uint64_t{1} << (SLOT_BITS * LEVELS);
+    if (delta >= range) {
+        // Beyond the wheel, park in the furthest slot and re-place when it
+        // cascades
+        expiry = currentTick + range - 1;
+    }
+
+    size_t slot = (expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+    timer.level = static_cast<uint8_t>(level);
+    timer.slot = static_cast<uint8_t>(slot);
+    slots[level][slot].push_back(id);
+    occupied[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::unlink(TimerId id, const Timer& timer) {
+    auto& bucket = slots[timer.level][timer.slot];
+    auto found = std::find(bucket.begin(), bucket.end(), id);
+    if (found != bucket.end()) {
+        *found = bucket.back();
+        bucket.pop_back();
+    }
+    if (bucket.empty()) {
+        occupied[timer.level] &= ~(uint64_t{1} << timer.slot);
+    }
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    auto found = timers.find(id);
+    if (found == timers.end()) {
+        return false;
+    }
+    unlink(id, found->second);
+    timers.erase(found);
+    return true;
+}
+
+std::optional<TimerClock::time_point> TimerWheel::nextDeadline() const {
+    if (timers.empty()) {
+        return std::nullopt;
+    }
+
+    uint64_t earliest = UINT64_MAX;
+    for (size_t level = 0; level < LEVELS; ++level) {
+        if (occupied[level] == 0) {
+            continue;
+        }
+        // The slot at the current position has already been processed, so the
+        // soonest slot of a level is the first occupied one after it
+        size_t position = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+        size_t slot = firstSetFrom(occupied[level], (position + 1) & SLOT_MASK);
+        for (TimerId id : slots[level][slot]) {
+            earliest = std::min(earliest, timers.at(id).expiry);
+        }
+    }
+    return epoch + Tick(earliest);
+}
+
+void TimerWheel::cascade() {
+    // Find the highest level whose slot starts at this tick. Higher levels
+    // must be emptied first since their timers may land in lower slots that
+    // are about to be emptied too.
+    size_t top = 1;
+    while (top + 1 < LEVELS &&
+           ((currentTick >> (SLOT_BITS * top)) & SLOT_MASK) == 0) {
+        ++top;
+    }
+
+    for (size_t level = top; level >= 1; --level) {
+        size_t slot = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+        std::vector<TimerId> moving;
+        moving.swap(slots[level][slot]);
+        occupied[level] &= ~(uint64_t{1} << slot);
+        for (TimerId id : moving) {
+            place(id, timers.at(id));
+        }
+    }
+}
+
+void TimerWheel::fireSlot(size_t slot,
+                          std::vector<std::shared_ptr<const Callback>>& due) {
+    if ((occupied[0] & (uint64_t{1} << slot)) == 0) {
+        return;
+    }
+
+    std::vector<TimerId> firing;
+    firing.swap(slots[0][slot]);
+    occupied[0] &= ~(uint64_t{1} << slot);
+
+    for (TimerId id : firing) {
+        auto found = timers.find(id);
+        Timer& timer = found->second;
+        due.push_back(timer.callback);
+
+        if (timer.period == 0) {
+            timers.erase(found);
+            continue;
+        }
+        timer.expiry =
+            std::max(timer.expiry + timer.period, currentTick + 1);
+        place(id, timer);
+    }
+}
+
+void TimerWheel::advance(TimerClock::time_point now,
+                         std::vector<std::shared_ptr<const Callback>>& due) {
+    uint64_t target = ticksUntil(now);
+
+    while (currentTick < target) {
+        if (timers.empty()) {
+            currentTick = target;
+            break;
+        }
+
+        uint64_t next = currentTick + 1;
+        if (occupied[0] == 0) {
+            // Nothing can fire before the next cascade, so jump straight to it
+            next = std::min(target, (currentTick | SLOT_MASK) + 1);
+        }
+        currentTick = next;
+
+        if ((currentTick & SLOT_MASK) == 0) {
+            cascade();
+        }
+        fireSlot(currentTick & SLOT_MASK, due);
+    }
+}
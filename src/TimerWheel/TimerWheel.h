@@ -0,0 +1,177 @@
+/**
+ * @file TimerWheel.h
+ * @author Amin Karic
+ * @brief Hierarchical timer wheel definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * The TimerWheel schedules one-shot and periodic callbacks with millisecond
+ * resolution. Timers are hashed into four levels of 64 slots each; the first
+ * level covers the next 64 ms and every further level covers 64 times the
+ * range of the previous one. Scheduling and cancelling are O(1) and advancing
+ * the wheel skips over empty stretches, so the cost does not depend on how
+ * long the owner slept.
+ *
+ * TimerWheel performs no synchronization. The Renderer owns one and guards it
+ * with its own mutex.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+using TimerClock = std::chrono::steady_clock;
+using TimerId = uint64_t;
+
+/**
+ * @class TimerWheel
+ *
+ * @brief Hierarchical timing wheel of callbacks.
+ */
+class TimerWheel {
+   public:
+    using Callback = std::function<void()>;
+
+   private:
+    static constexpr size_t LEVELS = 4;
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    /**
+     * @brief A scheduled callback.
+     */
+    struct Timer {
+        uint64_t expiry;  // Tick at which the timer fires
+        uint64_t period;  // Ticks between firings, 0 for one-shot timers
+        std::shared_ptr<const Callback> callback;
+        uint8_t level;  // Level of the slot holding the timer
+        uint8_t slot;   // Slot holding the timer
+    };
+
+    TimerClock::time_point epoch;  // Time of tick 0
+    uint64_t currentTick = 0;      // Last tick processed
+    TimerId nextId = 1;
+    std::unordered_map<TimerId, Timer> timers;
+    std::array<std::array<std::vector<TimerId>, SLOTS>, LEVELS> slots;
+    std::array<uint64_t, LEVELS> occupied{};  // Bit per non-empty slot
+
+    uint64_t ticksUntil(TimerClock::time_point t) const;
+
+    /**
+     * @brief Puts a timer into the slot matching its expiry.
+     */
+    void place(TimerId id, Timer& timer);
+
+    /**
+     * @brief Takes a timer out of its slot.
+     */
+    void unlink(TimerId id, const Timer& timer);
+
+    /**
+     * @brief Moves the timers of every higher level slot that starts at the
+     * current tick down to lower levels.
+     */
+    void cascade();
+
+    /**
+     * @brief Collects the callbacks of the timers in a first level slot and
+     * reschedules periodic ones.
+     */
+    void fireSlot(size_t slot,
+                  std::vector<std::shared_ptr<const Callback>>& due);
+
+    TimerId add(TimerClock::duration delay, TimerClock::duration period,
+                Callback callback, TimerClock::time_point now);
+
+   public:
+    /**
+     * @brief Construct a new TimerWheel
+     *
+     * @param now current time, tick 0 of the wheel
+     */
+    explicit TimerWheel(TimerClock::time_point now = TimerClock::now())
+        : epoch(now){};
+
+    TimerWheel(const TimerWheel& other) = delete;
+    TimerWheel& operator=(TimerWheel const& other) = delete;
+    TimerWheel(TimerWheel&& other) noexcept = default;
+    TimerWheel& operator=(TimerWheel&& other) noexcept = default;
+
+    ~TimerWheel() = default;
+
+    /**
+     * @brief Schedules a callback to run once.
+     *
+     * @param delay time from @p now until the callback runs, rounded up to
+     * whole milliseconds
+     * @param callback function to run
+     * @param now current time
+     * @return TimerId id that can be passed to cancel()
+     */
+    TimerId scheduleOnce(TimerClock::duration delay, Callback callback,
+                         TimerClock::time_point now = TimerClock::now()) {
+        return add(delay, TimerClock::duration::zero(), std::move(callback),
+                   now);
+    }
+
+    /**
+     * @brief Schedules a callback to run repeatedly.
+     *
+     * @param interval time between runs, at least one millisecond
+     * @param callback function to run
+     * @param now current time, the first run is one interval later
+     * @return TimerId id that can be passed to cancel()
+     *
+     * @details
+     * If the owner falls behind by more than one interval, missed runs are
+     * skipped rather than run back to back.
+     */
+    TimerId schedulePeriodic(TimerClock::duration interval, Callback callback,
+                             TimerClock::time_point now = TimerClock::now()) {
+        return add(interval, interval, std::move(callback), now);
+    }
+
+    /**
+     * @brief Cancels a timer.
+     *
+     * @param id id returned when the timer was scheduled
+     * @return true the timer was pending and is now cancelled
+     * @return false no such timer
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Returns whether no timers are scheduled.
+     */
+    bool empty() const noexcept { return timers.empty(); }
+
+    /**
+     * @brief Returns the number of scheduled timers.
+     */
+    size_t size() const noexcept { return timers.size(); }
+
+    /**
+     * @brief Returns the time the earliest timer fires, if any.
+     */
+    std::optional<TimerClock::time_point> nextDeadline() const;
+
+    /**
+     * @brief Advances the wheel to @p now and collects due callbacks.
+     *
+     * @param now current time
+     * @param due receives the callbacks of every timer that fired, in expiry
+     * order. The caller runs them, typically without holding any lock.
+     */
+    void advance(TimerClock::time_point now,
+                 std::vector<std::shared_ptr<const Callback>>& due);
+};
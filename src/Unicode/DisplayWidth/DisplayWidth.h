@@ -0,0 +1,70 @@
+/**
+ * @file DisplayWidth.h
+ * @author Amin Karic
+ * @brief Number of terminal cells a code point occupies.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * East Asian wide and fullwidth characters, including most emoji, take two
+ * cells. Combining marks, format characters such as the zero width joiner and
+ * control characters take none. Everything else takes one.
+ *
+ * Widths are looked up in a two-level table generated at compile time from
+ * range lists in DisplayWidth.cpp. The first level maps each block of 256 code
+ * points to one of a few distinct blocks, and the second level stores 2 bits
+ * per code point, so a lookup is two loads and a shift with no searching.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../Grapheme/ClusterTable/ClusterTable.h"
+
+inline constexpr size_t DISPLAY_WIDTH_BLOCK = 256;  // Code points per block
+inline constexpr size_t DISPLAY_WIDTH_MAX_BLOCKS = 128;  // Distinct blocks
+
+/**
+ * @brief Two-level display width table, generated in DisplayWidth.cpp.
+ */
+struct DisplayWidthTable {
+    // Distinct block used by each block of code points
+    uint8_t index[0x110000 / DISPLAY_WIDTH_BLOCK];
+    // Widths of the code points in a block, 2 bits each
+    uint8_t blocks[DISPLAY_WIDTH_MAX_BLOCKS][DISPLAY_WIDTH_BLOCK / 4];
+};
+
+extern const DisplayWidthTable DISPLAY_WIDTH_TABLE;
+
+/**
+ * @brief Returns the number of cells a code point occupies.
+ *
+ * @param c code point
+ * @return uint32_t 0, 1 or 2. Values past U+10FFFF are interned clusters,
+ * see ClusterTable.
+ */
+inline uint32_t displayWidth(char32_t c) noexcept {
+    if (ClusterTable::isCluster(c)) {
+        return ClusterTable::width(c);
+    }
+    const uint8_t* block =
+        DISPLAY_WIDTH_TABLE.blocks[DISPLAY_WIDTH_TABLE.index[c >> 8]];
+    uint8_t packed = block[(c & 0xFF) >> 2];
+    return (packed >> ((c & 3) * 2)) & 3;
+}
+
+/**
+ * @brief Returns the number of cells a string of code points occupies.
+ *
+ * @param text first code point
+ * @param length number of code points
+ */
+inline size_t displayWidth(const char32_t* text, size_t length) noexcept {
+    size_t cells = 0;
+    for (size_t i = 0; i < length; ++i) {
+        cells += displayWidth(text[i]);
+    }
+    return cells;
+}
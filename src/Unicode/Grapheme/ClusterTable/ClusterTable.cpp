@@ -0,0 +1,118 @@
+/**
+ * @file ClusterTable.cpp
+ * @author Amin Karic
+ * @brief ClusterTable implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for ClusterTable class.
+ */
+
+#include "ClusterTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "../../../ColoredChar/ColoredChar.h"
+#include "../../DisplayWidth/DisplayWidth.h"
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 256;   // Clusters per allocation
+constexpr size_t MAX_CHUNKS = 4096;  // Up to a million clusters
+
+/**
+ * @brief Storage for the interned clusters.
+ *
+ * @details
+ * Clusters are stored in fixed chunks that never move, so a published
+ * cluster can be read without a lock. Writers take the mutex, fill in the
+ * cluster and then publish it by raising the count.
+ */
+struct Storage {
+    std::mutex mtx;
+    std::unordered_map<std::u32string_view, char32_t> ids;  // Into chunks
+    std::atomic<ClusterTable::Cluster*> chunks[MAX_CHUNKS] = {};
+    std::atomic<size_t> count{0};
+};
+
+Storage& storage() {
+    // Never destroyed, cells may be printed until the very end
+    static Storage* instance = new Storage();
+    return *instance;
+}
+
+bool isRegionalIndicator(char32_t c) noexcept {
+    return c >= 0x1F1E6 && c <= 0x1F1FF;
+}
+
+}  // namespace
+
+char32_t ClusterTable::intern(const char32_t* text, size_t length) {
+    if (length == 1) {
+        return text[0];
+    }
+
+    Storage& s = storage();
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto found = s.ids.find(std::u32string_view(text, length));
+    if (found != s.ids.end()) {
+        return found->second;
+    }
+
+    size_t id = s.count.load(std::memory_order_relaxed);
+    if (id == CHUNK_SIZE * MAX_CHUNKS) {
+        return text[0];
+    }
+    Cluster* chunk = s.chunks[id / CHUNK_SIZE].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new Cluster[CHUNK_SIZE];
+        s.chunks[id / CHUNK_SIZE].store(chunk, std::memory_order_release);
+    }
+
+    Cluster& cluster = chunk[id % CHUNK_SIZE];
+    cluster.text.assign(text, length);
+    uint32_t width = 0;
+    for (char32_t c : cluster.text) {
+        width = std::max(width, displayWidth(c));
+        cluster.utf8 += toUTF8(c);
+    }
+    // Flags and emoji presentation selected with U+FE0F take two cells
+    // even though their code points are narrow on their own
+    if (isRegionalIndicator(text[0]) ||
+        cluster.text.find(U'\uFE0F') != std::u32string::npos) {
+        width = 2;
+    }
+    if (width == 0) {
+        // Marks with nothing to attach to are shown on a space
+        cluster.utf8.insert(0, 1, ' ');
+        width = 1;
+    }
+    cluster.width = width;
+
+    char32_t cell = FIRST_CLUSTER + static_cast<char32_t>(id);
+    s.ids.emplace(std::u32string_view(cluster.text), cell);
+    s.count.store(id + 1, std::memory_order_release);
+    return cell;
+}
+
+const ClusterTable::Cluster* ClusterTable::find(char32_t cell) noexcept {
+    if (!isCluster(cell)) {
+        return nullptr;
+    }
+    size_t id = cell - FIRST_CLUSTER;
+    Storage& s = storage();
+    if (id >= s.count.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &s.chunks[id / CHUNK_SIZE].load(std::memory_order_acquire)
+                [id % CHUNK_SIZE];
+}
+
+size_t ClusterTable::size() noexcept {
+    return storage().count.load(std::memory_order_acquire);
+}
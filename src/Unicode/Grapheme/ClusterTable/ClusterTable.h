@@ -0,0 +1,93 @@
+/**
+ * @file ClusterTable.h
+ * @author Amin Karic
+ * @brief ClusterTable class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A grapheme cluster such as "e" followed by a combining accent, a flag or a
+ * ZWJ emoji sequence is drawn as one character but made of several code
+ * points. To keep cells a fixed size, clusters of more than one code point are
+ * interned here once and cells refer to them with a value past U+10FFFF, the
+ * last code point. Comparing two cells still compares their whole content, so
+ * diffs and blits treat clusters like any other character.
+ *
+ * Interned clusters live for the rest of the program. Lookups take no lock,
+ * so the renderer can resolve clusters while other threads intern new ones.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ClusterTable
+ *
+ * @brief Process-wide table of interned grapheme clusters.
+ */
+class ClusterTable {
+   public:
+    static constexpr char32_t FIRST_CLUSTER = 0x110000;  // Cell of cluster 0
+
+    /**
+     * @brief An interned cluster.
+     */
+    struct Cluster {
+        std::u32string text;  // Code points
+        std::string utf8;     // Encoded for output
+        uint32_t width = 1;   // Cells occupied, 1 or 2
+    };
+
+    /**
+     * @brief Whether a cell refers to an interned cluster.
+     */
+    static bool isCluster(char32_t cell) noexcept {
+        return cell >= FIRST_CLUSTER;
+    }
+
+    /**
+     * @brief Returns the cell value for a cluster, interning it if needed.
+     *
+     * @param text code points of the cluster
+     * @param length number of code points, at least 1
+     * @return char32_t the code point itself for single code points, a
+     * cluster reference otherwise. If the table is full the first code point
+     * is returned.
+     */
+    static char32_t intern(const char32_t* text, size_t length);
+
+    /**
+     * @brief Looks up an interned cluster.
+     *
+     * @param cell cell value returned by intern()
+     * @return const Cluster* the cluster, nullptr if @p cell is not one
+     */
+    static const Cluster* find(char32_t cell) noexcept;
+
+    /**
+     * @brief Returns the number of cells a cluster occupies.
+     *
+     * @param cell cell value returned by intern()
+     * @return uint32_t 1 or 2, 1 for unknown references
+     */
+    static uint32_t width(char32_t cell) noexcept {
+        const Cluster* cluster = find(cell);
+        return cluster != nullptr ? cluster->width : 1;
+    }
+
+    /**
+     * @brief Returns the number of code points a cell stands for.
+     */
+    static size_t length(char32_t cell) noexcept {
+        const Cluster* cluster = isCluster(cell) ? find(cell) : nullptr;
+        return cluster != nullptr ? cluster->text.size() : 1;
+    }
+
+    /**
+     * @brief Number of interned clusters.
+     */
+    static size_t size() noexcept;
+};
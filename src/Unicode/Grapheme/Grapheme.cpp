@@ -0,0 +1,440 @@
+/**
+ * @file Grapheme.cpp
+ * @author Amin Karic
+ * @brief Grapheme cluster segmentation implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Grapheme.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include "ClusterTable/ClusterTable.h"
+
+namespace {
+
+/**
+ * @brief Grapheme_Cluster_Break property values, CR and LF count as Control.
+ */
+enum class Break : uint8_t {
+    Other,
+    Control,
+    Extend,
+    ZWJ,
+    RegionalIndicator,
+    Prepend,
+    SpacingMark,
+    L,
+    V,
+    T,
+    LV,
+    LVT,
+    ExtendedPictographic
+};
+
+struct BreakRange {
+    char32_t first;
+    char32_t last;
+    Break value;
+};
+
+// Grapheme_Cluster_Break and Extended_Pictographic ranges, sorted. Extend
+// covers the same marks as the zero width ranges in DisplayWidth.cpp. ASCII
+// and the precomposed Hangul syllables are computed in breakOf() instead.
+constexpr BreakRange BREAKS[] = {
+    {0x0, 0x9, Break::Control}, {0xB, 0xC, Break::Control},
+    {0xE, 0x1F, Break::Control}, {0x7F, 0x9F, Break::Control},
+    {0xA9, 0xA9, Break::ExtendedPictographic}, {0xAD, 0xAD, Break::Control},
+    {0xAE, 0xAE, Break::ExtendedPictographic}, {0x300, 0x36F, Break::Extend},
+    {0x483, 0x489, Break::Extend}, {0x591, 0x5BD, Break::Extend},
+    {0x5BF, 0x5BF, Break::Extend}, {0x5C1, 0x5C2, Break::Extend},
+    {0x5C4, 0x5C5, Break::Extend}, {0x5C7, 0x5C7, Break::Extend},
+    {0x600, 0x605, Break::Prepend}, {0x610, 0x61A, Break::Extend},
+    {0x61C, 0x61C, Break::Control}, {0x64B, 0x65F, Break::Extend},
+    {0x670, 0x670, Break::Extend}, {0x6D6, 0x6DC, Break::Extend},
+    {0x6DD, 0x6DD, Break::Prepend}, {0x6DF, 0x6E4, Break::Extend},
+    {0x6E7, 0x6E8, Break::Extend}, {0x6EA, 0x6ED, Break::Extend},
+    {0x70F, 0x70F, Break::Prepend}, {0x711, 0x711, Break::Extend},
+    {0x730, 0x74A, Break::Extend}, {0x7A6, 0x7B0, Break::Extend},
+    {0x7EB, 0x7F3, Break::Extend}, {0x7FD, 0x7FD, Break::Extend},
+    {0x816, 0x819, Break::Extend}, {0x81B, 0x823, Break::Extend},
+    {0x825, 0x827, Break::Extend}, {0x829, 0x82D, Break::Extend},
+    {0x859, 0x85B, Break::Extend}, {0x890, 0x891, Break::Prepend},
+    {0x898, 0x89F, Break::Extend}, {0x8CA, 0x8E1, Break::Extend},
+    {0x8E2, 0x8E2, Break::Prepend}, {0x8E3, 0x902, Break::Extend},
+    {0x903, 0x903, Break::SpacingMark}, {0x93A, 0x93A, Break::Extend},
+    {0x93B, 0x93B, Break::SpacingMark}, {0x93C, 0x93C, Break::Extend},
+    {0x93E, 0x940, Break::SpacingMark}, {0x941, 0x948, Break::Extend},
+    {0x949, 0x94C, Break::SpacingMark}, {0x94D, 0x94D, Break::Extend},
+    {0x94E, 0x94F, Break::SpacingMark}, {0x951, 0x957, Break::Extend},
+    {0x962, 0x963, Break::Extend}, {0x981, 0x981, Break::Extend},
+    {0x982, 0x983, Break::SpacingMark}, {0x9BC, 0x9BC, Break::Extend},
+    {0x9BF, 0x9C0, Break::SpacingMark}, {0x9C1, 0x9C4, Break::Extend},
+    {0x9C7, 0x9C8, Break::SpacingMark}, {0x9CB, 0x9CC, Break::SpacingMark},
+    {0x9CD, 0x9CD, Break::Extend}, {0x9E2, 0x9E3, Break::Extend},
+    {0x9FE, 0x9FE, Break::Extend}, {0xA01, 0xA02, Break::Extend},
+    {0xA03, 0xA03, Break::SpacingMark}, {0xA3C, 0xA3C, Break::Extend},
+    {0xA3E, 0xA40, Break::SpacingMark}, {0xA41, 0xA42, Break::Extend},
+    {0xA47, 0xA48, Break::Extend}, {0xA4B, 0xA4D, Break::Extend},
+    {0xA51, 0xA51, Break::Extend}, {0xA70, 0xA71, Break::Extend},
+    {0xA75, 0xA75, Break::Extend}, {0xA81, 0xA82, Break::Extend},
+    {0xA83, 0xA83, Break::SpacingMark}, {0xABC, 0xABC, Break::Extend},
+    {0xABE, 0xAC0, Break::SpacingMark}, {0xAC1, 0xAC5, Break::Extend},
+    {0xAC7, 0xAC8, Break::Extend}, {0xAC9, 0xAC9, Break::SpacingMark},
+    {0xACB, 0xACC, Break::SpacingMark}, {0xACD, 0xACD, Break::Extend},
+    {0xAE2, 0xAE3, Break::Extend}, {0xAFA, 0xAFF, Break::Extend},
+    {0xB01, 0xB01, Break::Extend}, {0xB02, 0xB03, Break::SpacingMark},
+    {0xB3C, 0xB3C, Break::Extend}, {0xB3F, 0xB3F, Break::Extend},
+    {0xB40, 0xB40, Break::SpacingMark}, {0xB41, 0xB44, Break::Extend},
+    {0xB47, 0xB48, Break::SpacingMark}, {0xB4B, 0xB4C, Break::SpacingMark},
+    {0xB4D, 0xB4D, Break::Extend}, {0xB55, 0xB56, Break::Extend},
+    {0xB62, 0xB63, Break::Extend}, {0xB82, 0xB82, Break::Extend},
+    {0xBBF, 0xBBF, Break::SpacingMark}, {0xBC0, 0xBC0, Break::Extend},
+    {0xBC1, 0xBC2, Break::SpacingMark}, {0xBC6, 0xBC8, Break::SpacingMark},
+    {0xBCA, 0xBCC, Break::SpacingMark}, {0xBCD, 0xBCD, Break::Extend},
+    {0xC00, 0xC00, Break::Extend}, {0xC01, 0xC03, Break::SpacingMark},
+    {0xC04, 0xC04, Break::Extend}, {0xC3C, 0xC3C, Break::Extend},
+    {0xC3E, 0xC40, Break::Extend}, {0xC41, 0xC44, Break::SpacingMark},
+    {0xC46, 0xC48, Break::Extend}, {0xC4A, 0xC4D, Break::Extend},
+    {0xC55, 0xC56, Break::Extend}, {0xC62, 0xC63, Break::Extend},
+    {0xC81, 0xC81, Break::Extend}, {0xC82, 0xC83, Break::SpacingMark},
+    {0xCBC, 0xCBC, Break::Extend}, {0xCBE, 0xCBE, Break::SpacingMark},
+    {0xCBF, 0xCBF, Break::Extend}, {0xCC0, 0xCC1, Break::SpacingMark},
+    {0xCC3, 0xCC4, Break::SpacingMark}, {0xCC6, 0xCC6, Break::Extend},
+    {0xCC7, 0xCC8, Break::SpacingMark}, {0xCCA, 0xCCB, Break::SpacingMark},
+    {0xCCC, 0xCCD, Break::Extend}, {0xCE2, 0xCE3, Break::Extend},
+    {0xD00, 0xD01, Break::Extend}, {0xD02, 0xD03, Break::SpacingMark},
+    {0xD3B, 0xD3C, Break::Extend}, {0xD3F, 0xD40, Break::SpacingMark},
+    {0xD41, 0xD44, Break::Extend}, {0xD46, 0xD48, Break::SpacingMark},
+    {0xD4A, 0xD4C, Break::SpacingMark}, {0xD4D, 0xD4D, Break::Extend},
+    {0xD4E, 0xD4E, Break::Prepend}, {0xD62, 0xD63, Break::Extend},
+    {0xD81, 0xD81, Break::Extend}, {0xD82, 0xD83, Break::SpacingMark},
+    {0xDCA, 0xDCA, Break::Extend}, {0xDD0, 0xDD1, Break::SpacingMark},
+    {0xDD2, 0xDD4, Break::Extend}, {0xDD6, 0xDD6, Break::Extend},
+    {0xDD8, 0xDDE, Break::SpacingMark}, {0xDF2, 0xDF3, Break::SpacingMark},
+    {0xE31, 0xE31, Break::Extend}, {0xE33, 0xE33, Break::SpacingMark},
+    {0xE34, 0xE3A, Break::Extend}, {0xE47, 0xE4E, Break::Extend},
+    {0xEB1, 0xEB1, Break::Extend}, {0xEB3, 0xEB3, Break::SpacingMark},
+    {0xEB4, 0xEBC, Break::Extend}, {0xEC8, 0xECE, Break::Extend},
+    {0xF18, 0xF19, Break::Extend}, {0xF35, 0xF35, Break::Extend},
+    {0xF37, 0xF37, Break::Extend}, {0xF39, 0xF39, Break::Extend},
+    {0xF3E, 0xF3F, Break::SpacingMark}, {0xF71, 0xF7E, Break::Extend},
+    {0xF7F, 0xF7F, Break::SpacingMark}, {0xF80, 0xF84, Break::Extend},
+    {0xF86, 0xF87, Break::Extend}, {0xF8D, 0xF97, Break::Extend},
+    {0xF99, 0xFBC, Break::Extend}, {0xFC6, 0xFC6, Break::Extend},
+    {0x102D, 0x1030, Break::Extend}, {0x1031, 0x1031, Break::SpacingMark},
+    {0x1032, 0x1037, Break::Extend}, {0x1039, 0x103A, Break::Extend},
+    {0x103B, 0x103C, Break::SpacingMark}, {0x103D, 0x103E, Break::Extend},
+    {0x1056, 0x1057, Break::SpacingMark}, {0x1058, 0x1059, Break::Extend},
+    {0x105E, 0x1060, Break::Extend}, {0x1071, 0x1074, Break::Extend},
+    {0x1082, 0x1082, Break::Extend}, {0x1084, 0x1084, Break::SpacingMark},
+    {0x1085, 0x1086, Break::Extend}, {0x108D, 0x108D, Break::Extend},
+    {0x109D, 0x109D, Break::Extend}, {0x1100, 0x115F, Break::L},
+    {0x1160, 0x11A7, Break::V}, {0x11A8, 0x11FF, Break::T},
+    {0x135D, 0x135F, Break::Extend}, {0x1712, 0x1714, Break::Extend},
+    {0x1732, 0x1733, Break::Extend}, {0x1752, 0x1753, Break::Extend},
+    {0x1772, 0x1773, Break::Extend}, {0x17B4, 0x17B5, Break::Extend},
+    {0x17B6, 0x17B6, Break::SpacingMark}, {0x17B7, 0x17BD, Break::Extend},
+    {0x17BE, 0x17C5, Break::SpacingMark}, {0x17C6, 0x17C6, Break::Extend},
+    {0x17C7, 0x17C8, Break::SpacingMark}, {0x17C9, 0x17D3, Break::Extend},
+    {0x17DD, 0x17DD, Break::Extend}, {0x180B, 0x180D, Break::Extend},
+    {0x180E, 0x180E, Break::Control}, {0x180F, 0x180F, Break::Extend},
+    {0x1885, 0x1886, Break::Extend}, {0x18A9, 0x18A9, Break::Extend},
+    {0x1920, 0x1922, Break::Extend}, {0x1923, 0x1926, Break::SpacingMark},
+    {0x1927, 0x1928, Break::Extend}, {0x1929, 0x192B, Break::SpacingMark},
+    {0x1930, 0x1931, Break::SpacingMark}, {0x1932, 0x1932, Break::Extend},
+    {0x1933, 0x1938, Break::SpacingMark}, {0x1939, 0x193B, Break::Extend},
+    {0x1A17, 0x1A18, Break::Extend}, {0x1A19, 0x1A1A, Break::SpacingMark},
+    {0x1A1B, 0x1A1B, Break::Extend}, {0x1A55, 0x1A55, Break::SpacingMark},
+    {0x1A56, 0x1A56, Break::Extend}, {0x1A57, 0x1A57, Break::SpacingMark},
+    {0x1A58, 0x1A5E, Break::Extend}, {0x1A60, 0x1A60, Break::Extend},
+    {0x1A62, 0x1A62, Break::Extend}, {0x1A65, 0x1A6C, Break::Extend},
+    {0x1A6D, 0x1A72, Break::SpacingMark}, {0x1A73, 0x1A7C, Break::Extend},
+    {0x1A7F, 0x1A7F, Break::Extend}, {0x1AB0, 0x1ACE, Break::Extend},
+    {0x1B00, 0x1B03, Break::Extend}, {0x1B04, 0x1B04, Break::SpacingMark},
+    {0x1B34, 0x1B34, Break::Extend}, {0x1B36, 0x1B3A, Break::Extend},
+    {0x1B3B, 0x1B3B, Break::SpacingMark}, {0x1B3C, 0x1B3C, Break::Extend},
+    {0x1B3D, 0x1B41, Break::SpacingMark}, {0x1B42, 0x1B42, Break::Extend},
+    {0x1B43, 0x1B44, Break::SpacingMark}, {0x1B6B, 0x1B73, Break::Extend},
+    {0x1B80, 0x1B81, Break::Extend}, {0x1B82, 0x1B82, Break::SpacingMark},
+    {0x1BA1, 0x1BA1, Break::SpacingMark}, {0x1BA2, 0x1BA5, Break::Extend},
+    {0x1BA6, 0x1BA7, Break::SpacingMark}, {0x1BA8, 0x1BA9, Break::Extend},
+    {0x1BAA, 0x1BAA, Break::SpacingMark}, {0x1BAB, 0x1BAD, Break::Extend},
+    {0x1BE6, 0x1BE6, Break::Extend}, {0x1BE7, 0x1BE7, Break::SpacingMark},
+    {0x1BE8, 0x1BE9, Break::Extend}, {0x1BEA, 0x1BEC, Break::SpacingMark},
+    {0x1BED, 0x1BED, Break::Extend}, {0x1BEE, 0x1BEE, Break::SpacingMark},
+    {0x1BEF, 0x1BF1, Break::Extend}, {0x1BF2, 0x1BF3, Break::SpacingMark},
+    {0x1C24, 0x1C2B, Break::SpacingMark}, {0x1C2C, 0x1C33, Break::Extend},
+    {0x1C34, 0x1C35, Break::SpacingMark}, {0x1C36, 0x1C37, Break::Extend},
+    {0x1CD0, 0x1CD2, Break::Extend}, {0x1CD4, 0x1CE0, Break::Extend},
+    {0x1CE1, 0x1CE1, Break::SpacingMark}, {0x1CE2, 0x1CE8, Break::Extend},
+    {0x1CED, 0x1CED, Break::Extend}, {0x1CF4, 0x1CF4, Break::Extend},
+    {0x1CF7, 0x1CF7, Break::SpacingMark}, {0x1CF8, 0x1CF9, Break::Extend},
+    {0x1DC0, 0x1DFF, Break::Extend}, {0x200B, 0x200B, Break::Control},
+    {0x200C, 0x200C, Break::Extend}, {0x200D, 0x200D, Break::ZWJ},
+    {0x200E, 0x200F, Break::Control}, {0x2028, 0x202E, Break::Control},
+    {0x203C, 0x203C, Break::ExtendedPictographic},
+    {0x2049, 0x2049, Break::ExtendedPictographic},
+    {0x2060, 0x206F, Break::Control}, {0x20D0, 0x20F0, Break::Extend},
+    {0x2122, 0x2122, Break::ExtendedPictographic},
+    {0x2139, 0x2139, Break::ExtendedPictographic},
+    {0x2194, 0x2199, Break::ExtendedPictographic},
+    {0x21A9, 0x21AA, Break::ExtendedPictographic},
+    {0x231A, 0x231B, Break::ExtendedPictographic},
+    {0x2328, 0x2328, Break::ExtendedPictographic},
+    {0x2388, 0x2388, Break::ExtendedPictographic},
+    {0x23CF, 0x23CF, Break::ExtendedPictographic},
+    {0x23E9, 0x23F3, Break::ExtendedPictographic},
+    {0x23F8, 0x23FA, Break::ExtendedPictographic},
+    {0x24C2, 0x24C2, Break::ExtendedPictographic},
+    {0x25AA, 0x25AB, Break::ExtendedPictographic},
+    {0x25B6, 0x25B6, Break::ExtendedPictographic},
+    {0x25C0, 0x25C0, Break::ExtendedPictographic},
+    {0x25FB, 0x25FE, Break::ExtendedPictographic},
+    {0x2600, 0x2605, Break::ExtendedPictographic},
+    {0x2607, 0x2612, Break::ExtendedPictographic},
+    {0x2614, 0x2685, Break::ExtendedPictographic},
+    {0x2690, 0x2705, Break::ExtendedPictographic},
+    {0x2708, 0x2712, Break::ExtendedPictographic},
+    {0x2714, 0x2714, Break::ExtendedPictographic},
+    {0x2716, 0x2716, Break::ExtendedPictographic},
+    {0x271D, 0x271D, Break::ExtendedPictographic},
+    {0x2721, 0x2721, Break::ExtendedPictographic},
+    {0x2728, 0x2728, Break::ExtendedPictographic},
+    {0x2733, 0x2734, Break::ExtendedPictographic},
+    {0x2744, 0x2744, Break::ExtendedPictographic},
+    {0x2747, 0x2747, Break::ExtendedPictographic},
+    {0x274C, 0x274C, Break::ExtendedPictographic},
+    {0x274E, 0x274E, Break::ExtendedPictographic},
+    {0x2753, 0x2755, Break::ExtendedPictographic},
+    {0x2757, 0x2757, Break::ExtendedPictographic},
+    {0x2763, 0x2767, Break::ExtendedPictographic},
+    {0x2795, 0x2797, Break::ExtendedPictographic},
+    {0x27A1, 0x27A1, Break::ExtendedPictographic},
+    {0x27B0, 0x27B0, Break::ExtendedPictographic},
+    {0x27BF, 0x27BF, Break::ExtendedPictographic},
+    {0x2934, 0x2935, Break::ExtendedPictographic},
+    {0x2B05, 0x2B07, Break::ExtendedPictographic},
+    {0x2B1B, 0x2B1C, Break::ExtendedPictographic},
+    {0x2B50, 0x2B50, Break::ExtendedPictographic},
+    {0x2B55, 0x2B55, Break::ExtendedPictographic},
+    {0x2CEF, 0x2CF1, Break::Extend}, {0x2D7F, 0x2D7F, Break::Extend},
+    {0x2DE0, 0x2DFF, Break::Extend}, {0x302A, 0x302D, Break::Extend},
+    {0x3030, 0x3030, Break::ExtendedPictographic},
+    {0x303D, 0x303D, Break::ExtendedPictographic},
+    {0x3099, 0x309A, Break::Extend},
+    {0x3297, 0x3297, Break::ExtendedPictographic},
+    {0x3299, 0x3299, Break::ExtendedPictographic},
+    {0xA66F, 0xA672, Break::Extend}, {0xA674, 0xA67D, Break::Extend},
+    {0xA69E, 0xA69F, Break::Extend}, {0xA6F0, 0xA6F1, Break::Extend},
+    {0xA802, 0xA802, Break::Extend}, {0xA806, 0xA806, Break::Extend},
+    {0xA80B, 0xA80B, Break::Extend}, {0xA823, 0xA824, Break::SpacingMark},
+    {0xA825, 0xA826, Break::Extend}, {0xA827, 0xA827, Break::SpacingMark},
+    {0xA82C, 0xA82C, Break::Extend}, {0xA880, 0xA881, Break::SpacingMark},
+    {0xA8B4, 0xA8C3, Break::SpacingMark}, {0xA8C4, 0xA8C5, Break::Extend},
+    {0xA8E0, 0xA8F1, Break::Extend}, {0xA8FF, 0xA8FF, Break::Extend},
+    {0xA926, 0xA92D, Break::Extend}, {0xA947, 0xA951, Break::Extend},
+    {0xA952, 0xA953, Break::SpacingMark}, {0xA960, 0xA97C, Break::L},
+    {0xA980, 0xA982, Break::Extend}, {0xA983, 0xA983, Break::SpacingMark},
+    {0xA9B3, 0xA9B3, Break::Extend}, {0xA9B4, 0xA9B5, Break::SpacingMark},
+    {0xA9B6, 0xA9B9, Break::Extend}, {0xA9BA, 0xA9BB, Break::SpacingMark},
+    {0xA9BC, 0xA9BD, Break::Extend}, {0xA9BE, 0xA9C0, Break::SpacingMark},
+    {0xA9E5, 0xA9E5, Break::Extend}, {0xAA29, 0xAA2E, Break::Extend},
+    {0xAA2F, 0xAA30, Break::SpacingMark}, {0xAA31, 0xAA32, Break::Extend},
+    {0xAA33, 0xAA34, Break::SpacingMark}, {0xAA35, 0xAA36, Break::Extend},
+    {0xAA43, 0xAA43, Break::Extend}, {0xAA4C, 0xAA4C, Break::Extend},
+    {0xAA4D, 0xAA4D, Break::SpacingMark}, {0xAA7C, 0xAA7C, Break::Extend},
+    {0xAAB0, 0xAAB0, Break::Extend}, {0xAAB2, 0xAAB4, Break::Extend},
+    {0xAAB7, 0xAAB8, Break::Extend}, {0xAABE, 0xAABF, Break::Extend},
+    {0xAAC1, 0xAAC1, Break::Extend}, {0xAAEB, 0xAAEB, Break::SpacingMark},
+    {0xAAEC, 0xAAED, Break::Extend}, {0xAAEE, 0xAAEF, Break::SpacingMark},
+    {0xAAF5, 0xAAF5, Break::SpacingMark}, {0xAAF6, 0xAAF6, Break::Extend},
+    {0xABE3, 0xABE4, Break::SpacingMark}, {0xABE5, 0xABE5, Break::Extend},
+    {0xABE6, 0xABE7, Break::SpacingMark}, {0xABE8, 0xABE8, Break::Extend},
+    {0xABE9, 0xABEA, Break::SpacingMark}, {0xABEC, 0xABEC, Break::SpacingMark},
+    {0xABED, 0xABED, Break::Extend}, {0xD7B0, 0xD7C6, Break::V},
+    {0xD7C7, 0xD7CA, Break::Extend}, {0xD7CB, 0xD7FB, Break::T},
+    {0xD7FC, 0xD7FF, Break::Extend}, {0xFB1E, 0xFB1E, Break::Extend},
+    {0xFE00, 0xFE0F, Break::Extend}, {0xFE20, 0xFE2F, Break::Extend},
+    {0xFEFF, 0xFEFF, Break::Control}, {0xFF9E, 0xFF9F, Break::Extend},
+    {0xFFF0, 0xFFFB, Break::Control}, {0x101FD, 0x101FD, Break::Extend},
+    {0x102E0, 0x102E0, Break::Extend}, {0x10376, 0x1037A, Break::Extend},
+    {0x10A01, 0x10A03, Break::Extend}, {0x10A05, 0x10A06, Break::Extend},
+    {0x10A0C, 0x10A0F, Break::Extend}, {0x10A38, 0x10A3A, Break::Extend},
+    {0x10A3F, 0x10A3F, Break::Extend}, {0x10AE5, 0x10AE6, Break::Extend},
+    {0x10D24, 0x10D27, Break::Extend}, {0x10EAB, 0x10EAC, Break::Extend},
+    {0x10F46, 0x10F50, Break::Extend}, {0x11001, 0x11001, Break::Extend},
+    {0x11038, 0x11046, Break::Extend}, {0x1107F, 0x11081, Break::Extend},
+    {0x110B3, 0x110B6, Break::Extend}, {0x110B9, 0x110BA, Break::Extend},
+    {0x110BD, 0x110BD, Break::Prepend}, {0x110C2, 0x110C2, Break::Extend},
+    {0x110CD, 0x110CD, Break::Prepend}, {0x11100, 0x11102, Break::Extend},
+    {0x11127, 0x1112B, Break::Extend}, {0x1112D, 0x11134, Break::Extend},
+    {0x11173, 0x11173, Break::Extend}, {0x11180, 0x11181, Break::Extend},
+    {0x111B6, 0x111BE, Break::Extend}, {0x111C2, 0x111C3, Break::Prepend},
+    {0x13430, 0x1343F, Break::Control}, {0x1BC9D, 0x1BC9E, Break::Extend},
+    {0x1BCA0, 0x1BCA3, Break::Control}, {0x1CF00, 0x1CF2D, Break::Extend},
+    {0x1CF30, 0x1CF46, Break::Extend}, {0x1D167, 0x1D169, Break::Extend},
+    {0x1D173, 0x1D17A, Break::Control}, {0x1D17B, 0x1D182, Break::Extend},
+    {0x1D185, 0x1D18B, Break::Extend}, {0x1D1AA, 0x1D1AD, Break::Extend},
+    {0x1D242, 0x1D244, Break::Extend}, {0x1E000, 0x1E006, Break::Extend},
+    {0x1E008, 0x1E018, Break::Extend}, {0x1E01B, 0x1E021, Break::Extend},
+    {0x1E023, 0x1E024, Break::Extend}, {0x1E026, 0x1E02A, Break::Extend},
+    {0x1E130, 0x1E136, Break::Extend}, {0x1E2EC, 0x1E2EF, Break::Extend},
+    {0x1E8D0, 0x1E8D6, Break::Extend}, {0x1E944, 0x1E94A, Break::Extend},
+    {0x1F000, 0x1F0FF, Break::ExtendedPictographic},
+    {0x1F10D, 0x1F10F, Break::ExtendedPictographic},
+    {0x1F12F, 0x1F12F, Break::ExtendedPictographic},
+    {0x1F16C, 0x1F171, Break::ExtendedPictographic},
+    {0x1F17E, 0x1F17F, Break::ExtendedPictographic},
+    {0x1F18E, 0x1F18E, Break::ExtendedPictographic},
+    {0x1F191, 0x1F19A, Break::ExtendedPictographic},
+    {0x1F1AD, 0x1F1E5, Break::ExtendedPictographic},
+    {0x1F1E6, 0x1F1FF, Break::RegionalIndicator},
+    {0x1F201, 0x1F20F, Break::ExtendedPictographic},
+    {0x1F21A, 0x1F21A, Break::ExtendedPictographic},
+    {0x1F22F, 0x1F22F, Break::ExtendedPictographic},
+    {0x1F232, 0x1F23A, Break::ExtendedPictographic},
+    {0x1F23C, 0x1F23F, Break::ExtendedPictographic},
+    {0x1F249, 0x1F3FA, Break::ExtendedPictographic},
+    {0x1F3FB, 0x1F3FF, Break::Extend},
+    {0x1F400, 0x1F53D, Break::ExtendedPictographic},
+    {0x1F546, 0x1F64F, Break::ExtendedPictographic},
+    {0x1F680, 0x1F6FF, Break::ExtendedPictographic},
+    {0x1F774, 0x1F77F, Break::ExtendedPictographic},
+    {0x1F7D5, 0x1F7FF, Break::ExtendedPictographic},
+    {0x1F80C, 0x1F80F, Break::ExtendedPictographic},
+    {0x1F848, 0x1F84F, Break::ExtendedPictographic},
+    {0x1F85A, 0x1F85F, Break::ExtendedPictographic},
+    {0x1F888, 0x1F88F, Break::ExtendedPictographic},
+    {0x1F8AE, 0x1F8FF, Break::ExtendedPictographic},
+    {0x1F90C, 0x1F93A, Break::ExtendedPictographic},
+    {0x1F93C, 0x1F945, Break::ExtendedPictographic},
+    {0x1F947, 0x1FAFF, Break::ExtendedPictographic},
+    {0x1FC00, 0x1FFFD, Break::ExtendedPictographic},
+    {0xE0000, 0xE001F, Break::Control}, {0xE0020, 0xE007F, Break::Extend},
+    {0xE0080, 0xE00FF, Break::Control}, {0xE0100, 0xE01EF, Break::Extend},
+    {0xE01F0, 0xE0FFF, Break::Control},
+};
+
+constexpr char32_t HANGUL_FIRST = 0xAC00;
+constexpr char32_t HANGUL_LAST = 0xD7A3;
+constexpr char32_t HANGUL_T_COUNT = 28;  // Syllables per leading pair
+
+Break breakOf(char32_t c) noexcept {
+    if (c < 0x80) {
+        return c < 0x20 || c == 0x7F ? Break::Control : Break::Other;
+    }
+    if (c >= HANGUL_FIRST && c <= HANGUL_LAST) {
+        return (c - HANGUL_FIRST) % HANGUL_T_COUNT == 0 ? Break::LV
+                                                       : Break::LVT;
+    }
+    const BreakRange* end = std::end(BREAKS);
+    const BreakRange* found = std::upper_bound(
+        std::begin(BREAKS), end, c,
+        [](char32_t value, const BreakRange& r) { return value < r.first; });
+    if (found == std::begin(BREAKS) || c > (found - 1)->last) {
+        return Break::Other;
+    }
+    return (found - 1)->value;
+}
+
+/**
+ * @brief Whether there is no boundary between two code points (GB3 to GB13).
+ *
+ * @param pictZWJ previous code point is a ZWJ after Extended_Pictographic
+ * Extend*
+ * @param oddIndicators an odd number of regional indicators precedes @p cur
+ */
+bool joins(Break prev, Break cur, bool pictZWJ, bool oddIndicators) noexcept {
+    if (prev == Break::Control || cur == Break::Control) {
+        return false;
+    }
+    switch (prev) {
+        case Break::L:
+            if (cur == Break::L || cur == Break::V || cur == Break::LV ||
+                cur == Break::LVT) {
+                return true;
+            }
+            break;
+        case Break::LV:
+        case Break::V:
+            if (cur == Break::V || cur == Break::T) {
+                return true;
+            }
+            break;
+        case Break::LVT:
+        case Break::T:
+            if (cur == Break::T) {
+                return true;
+            }
+            break;
+        case Break::Prepend:
+            return true;
+        default:
+            break;
+    }
+    if (cur == Break::Extend || cur == Break::ZWJ ||
+        cur == Break::SpacingMark) {
+        return true;
+    }
+    if (cur == Break::ExtendedPictographic && pictZWJ) {
+        return true;
+    }
+    return cur == Break::RegionalIndicator &&
+           prev == Break::RegionalIndicator && oddIndicators;
+}
+
+}  // namespace
+
+bool isTriviallySegmented(const char32_t* text, size_t length) noexcept {
+    // No early exit so the loop vectorizes, titles are short
+    bool joinable = false;
+    for (size_t i = 0; i < length; ++i) {
+        joinable |= text[i] >= 0x300;
+    }
+    return !joinable;
+}
+
+void segmentGraphemes(const char32_t* text, size_t length,
+                      std::u32string& cells) {
+    cells.clear();
+    if (length == 0) {
+        return;
+    }
+
+    Break prev = breakOf(text[0]);
+    bool inPict = prev == Break::ExtendedPictographic;
+    bool pictZWJ = false;
+    size_t indicators = prev == Break::RegionalIndicator ? 1 : 0;
+    size_t start = 0;
+
+    for (size_t i = 1; i < length; ++i) {
+        Break cur = breakOf(text[i]);
+        if (!joins(prev, cur, pictZWJ, indicators % 2 == 1)) {
+            cells.push_back(ClusterTable::intern(text + start, i - start));
+            start = i;
+        }
+
+        // Track the state GB11 and GB12/13 look back at
+        if (cur == Break::ExtendedPictographic) {
+            inPict = true;
+            pictZWJ = false;
+        } else if (cur == Break::Extend) {
+            pictZWJ = false;
+        } else if (cur == Break::ZWJ) {
+            pictZWJ = inPict;
+            inPict = false;
+        } else {
+            inPict = false;
+            pictZWJ = false;
+        }
+        indicators = cur == Break::RegionalIndicator ? indicators + 1 : 0;
+        prev = cur;
+    }
+    cells.push_back(ClusterTable::intern(text + start, length - start));
+}
@@ -0,0 +1,40 @@
+/**
+ * @file Grapheme.h
+ * @author Amin Karic
+ * @brief Grapheme cluster segmentation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Splits code points into the user-perceived characters of Unicode Standard
+ * Annex #29, so a letter with combining accents, a Hangul syllable written as
+ * jamo, a flag or a ZWJ emoji sequence each end up in one cell. Clusters of
+ * more than one code point are interned in ClusterTable.
+ *
+ * Two rules differ from the annex on purpose: CR and LF are never joined, so
+ * a line break is always a cell of its own, and the Indic conjunct rule GB9c
+ * is not applied, which only splits some conjuncts into their consonants.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Checks whether every code point is a cluster of its own.
+ *
+ * @return true if every code point is below U+0300, where none can join,
+ * in which case segmentation would return the text unchanged
+ */
+bool isTriviallySegmented(const char32_t* text, size_t length) noexcept;
+
+/**
+ * @brief Segments code points into cells, one per grapheme cluster.
+ *
+ * @param text code points
+ * @param length number of code points
+ * @param cells receives one cell per cluster, its capacity is reused
+ */
+void segmentGraphemes(const char32_t* text, size_t length,
+                      std::u32string& cells);
@@ -0,0 +1,55 @@
+/**
+ * @file GraphemeCache.cpp
+ * @author Amin Karic
+ * @brief GraphemeCache implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details Implementation file for GraphemeCache class.
+ */
+
+#include "GraphemeCache.h"
+
+#include <algorithm>
+
+#include "../Grapheme.h"
+
+GraphemeCache::GraphemeCache(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)) {}
+
+void GraphemeCache::segment(std::u32string_view text, std::u32string& cells) {
+    if (isTriviallySegmented(text.data(), text.size())) {
+        cells.assign(text.data(), text.size());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto found = index.find(text);
+    if (found != index.end()) {
+        // Move the hit to the front of the LRU list
+        entries.splice(entries.begin(), entries, found->second);
+        cells = found->second->cells;
+        return;
+    }
+
+    while (entries.size() >= capacity) {
+        index.erase(std::u32string_view(entries.back().text));
+        entries.pop_back();
+    }
+
+    segmentGraphemes(text.data(), text.size(), cells);
+    entries.push_front(Entry{std::u32string(text), cells});
+    index.emplace(std::u32string_view(entries.front().text), entries.begin());
+}
+
+void GraphemeCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    index.clear();
+    entries.clear();
+}
+
+GraphemeCache& GraphemeCache::shared() {
+    static GraphemeCache cache;
+    return cache;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file GraphemeCache.h
+ * @author Amin Karic
+ * @brief GraphemeCache class definition.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Titles and artist names are rebuilt into Text every time a track or
+ * template value changes, but the set of strings shown is small. Segmented
+ * results are kept in a small LRU cache keyed by the code points, so the same
+ * string is only segmented once while it stays in use.
+ */
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class GraphemeCache
+ *
+ * @brief LRU cache of grapheme cluster segmentations.
+ */
+class GraphemeCache {
+   private:
+    /**
+     * @brief A segmented string held in the LRU cache.
+     */
+    struct Entry {
+        std::u32string text;   // Code points, the key
+        std::u32string cells;  // One cell per cluster
+    };
+
+    std::mutex mtx;                // Guards the cache
+    size_t capacity;               // Maximum strings in the cache
+    std::list<Entry> entries;      // Most recently used first
+    std::unordered_map<std::u32string_view, std::list<Entry>::iterator>
+        index;                     // Text to cache entry
+
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;  // Strings kept
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity maximum number of strings kept
+     */
+    explicit GraphemeCache(size_t capacity = DEFAULT_CAPACITY);
+
+    GraphemeCache(const GraphemeCache&) = delete;
+    GraphemeCache& operator=(const GraphemeCache&) = delete;
+
+    /**
+     * @brief Segments text into cells, one per grapheme cluster.
+     *
+     * @details
+     * Text made only of code points that cannot join is returned as is
+     * without touching the cache.
+     *
+     * @param text code points
+     * @param cells receives one cell per cluster, its capacity is reused
+     */
+    void segment(std::u32string_view text, std::u32string& cells);
+
+    /**
+     * @brief Drops every cached string.
+     */
+    void clear();
+
+    /**
+     * @brief Cache shared by the components.
+     */
+    static GraphemeCache& shared();
+};
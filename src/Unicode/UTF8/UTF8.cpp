@@ -0,0 +1,168 @@
+/**
+ * @file UTF8.cpp
+ * @author Amin Karic
+ * @brief Bulk UTF-8 decoding and validation implementation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "UTF8.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MUSCLI_UTF8_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MUSCLI_UTF8_NEON
+#endif
+
+namespace {
+
+constexpr size_t BLOCK = 16;  // Bytes checked per ASCII step
+
+/**
+ * @brief Counts the ASCII bytes at the start of a 16 byte block.
+ *
+ * @return size_t 16 if the whole block is ASCII
+ */
+inline size_t asciiPrefix(const unsigned char* p) noexcept {
+#if defined(MUSCLI_UTF8_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(bytes));
+    return mask == 0 ? BLOCK : static_cast<size_t>(__builtin_ctz(mask));
+#elif defined(MUSCLI_UTF8_NEON)
+    uint8x16_t bytes = vld1q_u8(p);
+    if (vmaxvq_u8(bytes) < 0x80) {
+        return BLOCK;
+    }
+    size_t n = 0;
+    while (p[n] < 0x80) {
+        ++n;
+    }
+    return n;
+#else
+    uint64_t words[2];
+    std::memcpy(words, p, BLOCK);
+    if (((words[0] | words[1]) & 0x8080808080808080ULL) == 0) {
+        return BLOCK;
+    }
+    size_t n = 0;
+    while (p[n] < 0x80) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief Widens 16 ASCII bytes to code points.
+ */
+inline void widenBlock(const unsigned char* p, char32_t* out) noexcept {
+#if defined(MUSCLI_UTF8_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+    _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+#elif defined(MUSCLI_UTF8_NEON)
+    uint8x16_t bytes = vld1q_u8(p);
+    uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+    uint32_t* dst = reinterpret_cast<uint32_t*>(out);
+    vst1q_u32(dst + 0, vmovl_u16(vget_low_u16(low)));
+    vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(low)));
+    vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(high)));
+    vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(high)));
+#else
+    for (size_t i = 0; i < BLOCK; ++i) {
+        out[i] = p[i];
+    }
+#endif
+}
+
+// True if a step produced U+FFFD for malformed bytes rather than decoding one
+inline bool replacedMalformed(const unsigned char* p, size_t used,
+                              char32_t c) noexcept {
+    return c == REPLACEMENT_CHARACTER &&
+           !(used == 3 && p[0] == 0xEF && p[1] == 0xBF && p[2] == 0xBD);
+}
+
+}  // namespace
+
+size_t decodeUTF8(const char* data, size_t size, char32_t* out,
+                  size_t* replaced) noexcept {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    char32_t* o = out;
+    size_t bad = 0;
+    size_t i = 0;
+
+    while (i < size) {
+        if (size - i >= BLOCK) {
+            size_t ascii = asciiPrefix(p + i);
+            if (ascii == BLOCK) {
+                widenBlock(p + i, o);
+                i += BLOCK;
+                o += BLOCK;
+                continue;
+            }
+            // Copy the ASCII before the first multi-byte sequence
+            for (size_t end = i + ascii; i < end; ++i) {
+                *o++ = p[i];
+            }
+        } else if (p[i] < 0x80) {
+            *o++ = p[i++];
+            continue;
+        }
+
+        size_t used = decodeUTF8Step(p + i, size - i, *o);
+        bad += replacedMalformed(p + i, used, *o);
+        i += used;
+        ++o;
+    }
+
+    if (replaced != nullptr) {
+        *replaced = bad;
+    }
+    return static_cast<size_t>(o - out);
+}
+
+void decodeUTF8(std::string_view text, std::u32string& out) {
+    // Never more code points than bytes
+    out.resize(text.size());
+    out.resize(decodeUTF8(text.data(), text.size(), out.data()));
+}
+
+bool isValidUTF8(std::string_view text) noexcept {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+    size_t i = 0;
+
+    while (i < size) {
+        if (size - i >= BLOCK) {
+            size_t ascii = asciiPrefix(p + i);
+            i += ascii;
+            if (ascii == BLOCK) {
+                continue;
+            }
+        } else if (p[i] < 0x80) {
+            ++i;
+            continue;
+        }
+
+        char32_t c;
+        size_t used = decodeUTF8Step(p + i, size - i, c);
+        if (replacedMalformed(p + i, used, c)) {
+            return false;
+        }
+        i += used;
+    }
+    return true;
+}
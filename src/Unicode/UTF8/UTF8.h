@@ -0,0 +1,129 @@
+/**
+ * @file UTF8.h
+ * @author Amin Karic
+ * @brief Bulk UTF-8 decoding and validation.
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Tag and metadata strings are decoded in bulk. Runs of ASCII, which make up
+ * most tags, are checked and widened 16 bytes at a time with SSE2 or NEON,
+ * and 8 bytes at a time elsewhere. Other sequences go through a scalar
+ * decoder that follows the Unicode well-formedness table, so overlong forms,
+ * surrogates and code points above U+10FFFF are rejected. Malformed input is
+ * never an error: each maximal invalid subpart becomes one U+FFFD, which is
+ * the recovery recommended by the Unicode standard.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Code point substituted for malformed input.
+ */
+inline constexpr char32_t REPLACEMENT_CHARACTER = U'�';
+
+/**
+ * @brief Decodes one code point.
+ *
+ * @param p first byte of the sequence
+ * @param remaining number of readable bytes at @p p, at least 1
+ * @param out receives the code point, REPLACEMENT_CHARACTER if malformed
+ * @return size_t number of bytes consumed, 1 to 4
+ */
+inline size_t decodeUTF8Step(const unsigned char* p, size_t remaining,
+                             char32_t& out) noexcept {
+    unsigned char lead = p[0];
+    if (lead < 0x80) {
+        out = lead;
+        return 1;
+    }
+
+    // Allowed range of the first continuation byte depends on the lead byte,
+    // which rules out overlong forms, surrogates and values past U+10FFFF
+    size_t need;
+    char32_t code;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        need = 1;
+        code = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        need = 2;
+        code = lead & 0x0F;
+        if (lead == 0xE0) {
+            low = 0xA0;
+        } else if (lead == 0xED) {
+            high = 0x9F;
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        need = 3;
+        code = lead & 0x07;
+        if (lead == 0xF0) {
+            low = 0x90;
+        } else if (lead == 0xF4) {
+            high = 0x8F;
+        }
+    } else {
+        out = REPLACEMENT_CHARACTER;
+        return 1;
+    }
+
+    for (size_t k = 1; k <= need; ++k) {
+        if (k >= remaining || p[k] < low || p[k] > high) {
+            // Consume the valid prefix as one replacement
+            out = REPLACEMENT_CHARACTER;
+            return k;
+        }
+        code = (code << 6) | (p[k] & 0x3F);
+        low = 0x80;
+        high = 0xBF;
+    }
+    out = code;
+    return need + 1;
+}
+
+/**
+ * @brief Decodes UTF-8 into a caller provided buffer.
+ *
+ * @param data UTF-8 bytes
+ * @param size number of bytes
+ * @param out buffer with room for at least @p size code points
+ * @param replaced if not null, receives the number of replacement characters
+ * substituted for malformed input
+ * @return size_t number of code points written
+ */
+size_t decodeUTF8(const char* data, size_t size, char32_t* out,
+                  size_t* replaced = nullptr) noexcept;
+
+/**
+ * @brief Decodes UTF-8, replacing the contents of @p out.
+ *
+ * @param text UTF-8 text
+ * @param out receives the code points, its capacity is reused
+ */
+void decodeUTF8(std::string_view text, std::u32string& out);
+
+/**
+ * @brief Decodes UTF-8.
+ *
+ * @param text UTF-8 text
+ * @return std::u32string code points
+ */
+inline std::u32string decodeUTF8(std::string_view text) {
+    std::u32string out;
+    decodeUTF8(text, out);
+    return out;
+}
+
+/**
+ * @brief Checks whether text is well-formed UTF-8.
+ *
+ * @param text bytes to check
+ * @return true if decoding would not substitute any replacement characters
+ */
+bool isValidUTF8(std::string_view text) noexcept;
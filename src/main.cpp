@@ -4,14 +4,19 @@
 #include <cstdint>
 #include <memory>
 
-// Headers for dummy thread test
-#include <atomic>
 #include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 
+#include "Animator/Animator.h"
+#include "ColoredChar/Palette/Palette.h"
 #include "Component/AlbumAsciiArt/AlbumAsciiArt.h"
+#include "Component/AlbumAsciiArt/ArtLoader/ArtLoader.h"
+#include "Component/AlbumAsciiArt/MipChain/DominantColors/DominantColors.h"
+#include "Component/AlbumAsciiArt/ThumbnailCache/ThumbnailCache.h"
 #include "Component/SeekBar/SeekBar.h"
+#include "Component/Text/MarkupTemplate/MarkupTemplate.h"
 #include "Component/Text/Text.h"
 #include "Menu/Menu.h"
 #include "Renderer/Renderer.h"
@@ -38,61 +43,133 @@ int main() {
     // uint32_t height = getTerminalHeight();
     uint32_t width = 80;
     uint32_t height = 24;
+    ColorTier colors = Palette::detect();
 
     Menu* m = new Menu(width, height - 1);
-    m->addComponent(std::make_unique<Text>(40, 5, "Starboy", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(40, 6, "The Weeknd", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(41, 13, "S", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(48, 13, "<<", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(55, 13, "||", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(62, 13, ">>", 255, 255, 255));
-    m->addComponent(std::make_unique<Text>(70, 13, "L", 255, 255, 255));
-    m->addComponent(std::unique_ptr<SeekBar>(new SeekBar(40, 11, 30, 70)));
-    m->addComponent(
-        std::make_unique<Text>(40, 10, "3:15 / 4:20", 255, 255, 255));
-    auto art = std::make_unique<AlbumAsciiArt>("starboy.png", 5, 3);
+    Text* title = m->emplaceComponent<Text>(0, 0, "Starboy", 255, 255, 255);
+    Text* artist = m->emplaceComponent<Text>(0, 0, "The Weeknd feat. Daft Punk",
+                                             255, 255, 255);
+    artist->setMarquee(16);
+    Text* shuffle = m->emplaceComponent<Text>(0, 0, "S", 255, 255, 255);
+    Text* previous = m->emplaceComponent<Text>(0, 0, "<<", 255, 255, 255);
+    Text* pause = m->emplaceComponent<Text>(0, 0, "||", 255, 255, 255);
+    Text* next = m->emplaceComponent<Text>(0, 0, ">>", 255, 255, 255);
+    Text* loop = m->emplaceComponent<Text>(0, 0, "L", 255, 255, 255);
+    SeekBar* seekBar = m->emplaceComponent<SeekBar>(0, 0, 30, 70);
+    Text* time =
+        m->emplaceComponent<Text>(0, 0, "3:15 / 4:20", 255, 255, 255);
+    // Blank until the loader below has decoded the cover
+    AlbumAsciiArt* art = m->emplaceComponent<AlbumAsciiArt>(0, 0);
+    art->setMode(ArtMode::HalfBlock);
+    art->setColorTier(colors);
+    // Accents follow the cover once it is loaded
+    art->setOnPalette([title, seekBar](const std::vector<uint32_t>& dominant) {
+        uint32_t accent = DominantColors::accent(dominant, CCHAR_WHITE);
+        title->paintFG(accent);
+        seekBar->setColors(accent, 0x424242FF);
+    });
     // art->AlbumAsciiArt_Test();
-    m->addComponent(std::unique_ptr<Component>(std::move(art)));
 
-    std::atomic<bool> running{true};
+    Text* dynamicTextPtr =
+        m->emplaceComponent<Text>(0, 0, "Initial text", 255, 255, 255);
+
+    // Album art on the left, track info and controls on the right
+    Layout& layout = m->getLayout();
+    LayoutNode* root = layout.getRoot();
+    root->setDirection(Direction::Horizontal);
+    root->setPadding({4, 2, 4, 1});
+    root->setSpacing(5);
+    layout.addComponent(root, art, SizeSpec::fixed(30), SizeSpec::fixed(15));
+
+    LayoutNode* info = layout.addStack(root, Direction::Vertical);
+    info->setPadding({0, 2, 0, 0});
+    layout.addComponent(info, title);
+    layout.addComponent(info, artist);
+    layout.addSpacer(info, SizeSpec::flex(), SizeSpec::fixed(3));
+    layout.addComponent(info, time);
+    layout.addComponent(info, seekBar, SizeSpec::flex(), SizeSpec::fixed(1),
+                        true);
+    layout.addSpacer(info, SizeSpec::flex(), SizeSpec::fixed(1));
+
+    LayoutNode* controls = layout.addStack(info, Direction::Horizontal,
+                                           SizeSpec::flex(), SizeSpec::fixed(1));
+    controls->setPadding({1, 0, 1, 0});
+    Text* buttons[] = {shuffle, previous, pause, next, loop};
+    for (size_t i = 0; i < 5; ++i) {
+        if (i > 0) {
+            layout.addSpacer(controls, SizeSpec::flex(), SizeSpec::fixed(1));
+        }
+        layout.addComponent(controls, buttons[i]);
+    }
 
-    auto dynamicText =
-        std::make_unique<Text>(40, 20, "Initial text", 255, 255, 255);
-    Text* dynamicTextPtr = dynamicText.get();
-    m->addComponent(std::move(dynamicText));
+    layout.addSpacer(info, SizeSpec::flex(), SizeSpec::flex());
+    layout.addComponent(info, dynamicTextPtr);
 
     InputState inputState{};
     Renderer renderer(inputState, {m});
+    renderer.setColorTier(colors);
     TextInput textInput(inputState, renderer);
 
     std::thread rendererThread([&renderer]() { renderer.run(); });
 
     std::thread textInputThread([&textInput]() { textInput.run(); });
 
-    std::thread dummyWorker([&]() {
-        int counter = 0;
-
-        while (running) {
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-
-            // Generate dummy text
-            std::string msg = "Update #" + std::to_string(counter++);
-
-            // Update shared data (Text object)
-            dynamicTextPtr->rebuildFromString(msg);
+    Animator animator(renderer);
+
+    // Decode the cover off the renderer and input threads, covers seen in
+    // earlier runs come from the thumbnail cache
+    ThumbnailCache thumbnails(ThumbnailCache::defaultPath());
+    ArtLoader artLoader(renderer, &thumbnails);
+    artLoader.loadFromFile(art, "starboy.png");
+
+    // Tick the elapsed time, the line is parsed once and only the digits
+    // that change are redrawn
+    MarkupTemplate timeLine("[b]{elapsed}[/b] [dim]/ {total}[/dim]");
+    timeLine.setValue("total", "4:20");
+    int elapsed = 3 * 60 + 15;
+    renderer.schedulePeriodic(std::chrono::seconds(1), [&]() {
+        elapsed = (elapsed + 1) % (4 * 60 + 20);
+        std::string seconds = std::to_string(elapsed % 60);
+        timeLine.setValue("elapsed", std::to_string(elapsed / 60) + ":" +
+                                         (seconds.size() < 2 ? "0" : "") +
+                                         seconds);
+        timeLine.apply(*time);
+        renderer.requestPartialRedraw();
+    });
 
-            // Tell renderer something changed
-            renderer.requestRedraw();
+    // Scroll names that do not fit, only the scrolled text is redrawn
+    renderer.schedulePeriodic(std::chrono::milliseconds(250), [&]() {
+        if (artist->advanceMarquee()) {
+            renderer.requestPartialRedraw();
         }
     });
 
-    std::this_thread::sleep_for(std::chrono::seconds(30));
+    // Dummy periodic update, runs on the renderer thread
+    int counter = 0;
+    renderer.schedulePeriodic(std::chrono::seconds(5), [&]() {
+        // Generate dummy text
+        std::string msg = "Update #" + std::to_string(counter++);
+
+        // Update shared data (Text object)
+        dynamicTextPtr->rebuildFromString(msg);
+
+        // Tell renderer something changed
+        renderer.requestRedraw();
+
+        // Ease the seek bar forward, only the bar is redrawn while it moves
+        float from = seekBar->getProgress();
+        float to = static_cast<float>((seekBar->getProgress() + 10) % 100);
+        animator.animate(seekBar, std::chrono::milliseconds(400), from, to,
+                         [seekBar](float value) {
+                             seekBar->setProgress(
+                                 static_cast<uint8_t>(value + 0.5f));
+                         });
+    });
 
-    running = false;
+    std::this_thread::sleep_for(std::chrono::seconds(30));
 
     renderer.stop();
 
-    dummyWorker.join();
     rendererThread.join();
 
     // while (1) {